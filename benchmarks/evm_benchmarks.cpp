@@ -0,0 +1,217 @@
+// Native micro-benchmarks of the EVM-facing kernels of the system contract: the uint256 arithmetic of the
+// vote decay and of the EVM vote normalization, the lookup of the producer schedule metrics done on every
+// block, and RLP encoding and decoding of EVM transactions. Each
+// kernel reports ns/op and allocations/op, so that changes to these headers can be measured before they
+// reach contract CPU billing. The vote kernels are the ones of `eosio.system/vote_math.hpp` and the metrics
+// lookup the one of `eosio.system/schedule_lookup.hpp`, the contract runs the same code. The kernels marked as baseline are frozen copies of the code they replaced.
+//
+// The contracts run these kernels in WebAssembly, absolute timings differ, relative ones are what to compare.
+
+#include <eosio/eosio.hpp>
+
+#include <intx/intx.hpp>
+#include <intx/base.hpp>
+#include <eosio.evm/util.hpp>
+#include <eosio.system/vote_math.hpp>
+#include <eosio.system/schedule_lookup.hpp>
+#include <rlp/rlp.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string_view>
+
+namespace rlp { const RLPValue& NullRLPValue = RLPValue(); }
+
+namespace {
+   size_t allocations = 0;
+}
+
+void* operator new( size_t size ) {
+   ++allocations;
+   if( void* p = std::malloc( size ? size : 1 ) )
+      return p;
+   throw std::bad_alloc();
+}
+
+void operator delete( void* p ) noexcept { std::free( p ); }
+void operator delete( void* p, size_t ) noexcept { std::free( p ); }
+
+namespace {
+   // Folded into the output so that the compiler cannot drop the kernels
+   uint64_t sink = 0;
+
+   void consume( uint64_t v ) { sink ^= v + 0x9e3779b97f4a7c15ULL + ( sink << 6 ) + ( sink >> 2 ); }
+   void consume( const uint256_t& v ) { consume( v.lo.lo ^ v.lo.hi ^ v.hi.lo ^ v.hi.hi ); }
+   void consume( double v ) { uint64_t bits; std::memcpy( &bits, &v, sizeof( bits ) ); consume( bits ); }
+   void consume( const std::string& s ) { consume( uint64_t( s.size() ) ^ uint64_t( uint8_t( s.back() ) ) ); }
+
+   // Runs `kernel` on every input, for enough rounds to last about `budget`
+   template <typename Input, typename Kernel>
+   void run( const char* name, const std::vector<Input>& inputs, Kernel&& kernel,
+             std::chrono::milliseconds budget = std::chrono::milliseconds( 200 ) ) {
+      for( const auto& in : inputs ) // warm up
+         consume( kernel( in ) );
+
+      size_t ops = 0;
+      const size_t allocations_before = allocations;
+      const auto start = std::chrono::steady_clock::now();
+      auto elapsed = std::chrono::steady_clock::duration::zero();
+      while( elapsed < budget ) {
+         for( const auto& in : inputs )
+            consume( kernel( in ) );
+         ops += inputs.size();
+         elapsed = std::chrono::steady_clock::now() - start;
+      }
+      const double ns = std::chrono::duration<double, std::nano>( elapsed ).count();
+      std::printf( "%-44s %12.1f ns/op %10.2f allocs/op\n", name, ns / ops, double( allocations - allocations_before ) / ops );
+   }
+
+   // Baseline: the 256-bit path of `decay_multiplier` with the precision built at run time and the generic
+   // 256-bit division
+   double decay_multiplier_generic( uint64_t seconds_of_decay, uint64_t decay_increase_yearly_pct ) {
+      constexpr uint64_t SECONDS_PER_YEAR = 31'536'000ULL;
+      const uint256_t DECAY_PRECISION = uint256_t{ 1'000'000'000'000'000'000ULL };
+      const uint256_t yearly_rate_scaled = uint256_t{ decay_increase_yearly_pct } * DECAY_PRECISION / 100ULL;
+      const uint256_t increment_fp = ( yearly_rate_scaled * uint256_t{ seconds_of_decay } ) / SECONDS_PER_YEAR;
+      const uint256_t decay_multiplier_fp = DECAY_PRECISION + increment_fp;
+      return eosiosystem::vote_math::uint256_to_double( decay_multiplier_fp ) /
+             eosiosystem::vote_math::uint256_to_double( DECAY_PRECISION );
+   }
+
+   // Baseline: `evm_vote_weight` with 1e14 parsed at run time and the generic 256-bit division
+   uint64_t evm_vote_weight_generic( const eosio::checksum256& total_vote ) {
+      const uint256_t ten_power_14 = intx::from_string<uint256_t>( "0x5af3107a4000" );
+      uint256_t vote_normalized = eosio_evm::checksum256ToValue( total_vote ) / ten_power_14;
+      return vote_normalized.lo.lo;
+   }
+
+   // Layout of `producer_metric`, `bp_name` is an `eosio::name`, a uint64_t
+   struct producer_metric {
+      uint64_t bp_name;
+      uint32_t missed_blocks_per_cycle;
+   };
+
+   // Baseline: the linear scan of the schedule metrics that the binary search replaced
+   producer_metric* find_producer_metric_linear( std::vector<producer_metric>& metrics, uint64_t producer ) {
+      for( auto& pm : metrics )
+         if( pm.bp_name == producer )
+            return &pm;
+      return nullptr;
+   }
+
+   // Name-sorted metrics of a schedule of `size` producers, and the producers of the blocks to look up:
+   // every scheduled producer in turn, in schedule order rather than name order
+   std::pair<std::vector<producer_metric>, std::vector<uint64_t>> schedule_metrics( std::mt19937_64& rng, size_t size ) {
+      std::vector<producer_metric> metrics;
+      for( size_t i = 0; i < size; ++i )
+         metrics.push_back( { rng(), uint32_t( 12 ) } );
+      std::vector<uint64_t> lookups;
+      for( const auto& pm : metrics )
+         lookups.push_back( pm.bp_name );
+      std::sort( metrics.begin(), metrics.end(), []( const auto& a, const auto& b ) { return a.bp_name < b.bp_name; } );
+      return { std::move( metrics ), std::move( lookups ) };
+   }
+
+   struct evm_tx {
+      uint256_t                nonce;
+      std::array<uint8_t, 20>  to;
+      std::array<uint8_t, 36>  data;
+   };
+
+   template <typename... Args>
+   std::string tree_encode( Args... args ) {
+      rlp::RLPValue rlp;
+      rlp.set_array();
+      (rlp.encode_single( args ), ...);
+      return rlp.write();
+   }
+
+   std::string encode_tx( const evm_tx& tx ) {
+      return rlp::encode( tx.nonce, uint256_t( 0 ), uint256_t( 100000 ), tx.to, uint256_t( 0 ), tx.data,
+                          uint8_t( 0 ), uint256_t( 0 ), uint256_t( 0 ) );
+   }
+}
+
+int main() {
+   std::mt19937_64 rng( 2024 );
+   constexpr size_t input_count = 256;
+
+   // one to ten years of decay at rates up to 100 % a year, the contract always takes the 128-bit path there
+   std::vector<std::pair<uint64_t, uint64_t>> decays;
+   for( size_t i = 0; i < input_count; ++i )
+      decays.emplace_back( 31'536'000ULL * ( 1 + rng() % 10 ), rng() % 101 );
+
+   // EVM vote totals in wei, up to 10^9 TLOS
+   std::vector<eosio::checksum256> totals;
+   for( size_t i = 0; i < input_count; ++i ) {
+      const uint256_t total = uint256_t( rng() ) * uint256_t( rng() % 100000000000ULL );
+      uint8_t be_total[32] = {};
+      intx::be::store( be_total, total );
+      std::array<uint8_t, 32> bytes{};
+      std::copy( std::begin( be_total ), std::end( be_total ), bytes.begin() );
+      totals.emplace_back( bytes );
+   }
+
+   std::vector<evm_tx> txs;
+   for( size_t i = 0; i < input_count; ++i ) {
+      evm_tx tx{ uint256_t( rng() % 1000000 ), {}, {} };
+      for( auto& b : tx.to ) b = rng();
+      for( auto& b : tx.data ) b = rng();
+      txs.push_back( tx );
+   }
+   std::vector<std::string> encoded;
+   for( const auto& tx : txs )
+      encoded.push_back( encode_tx( tx ) );
+
+   run( "decay multiplier (contract)", decays, []( const auto& d ) {
+      return eosiosystem::vote_math::decay_multiplier( uint32_t( d.first + 1 ), 1, d.second );
+   });
+   run( "decay multiplier (256-bit path)", decays, []( const auto& d ) {
+      return eosiosystem::vote_math::decay_multiplier_256( d.first, d.second );
+   });
+   run( "decay multiplier (baseline, generic division)", decays, []( const auto& d ) {
+      return decay_multiplier_generic( d.first, d.second );
+   });
+   run( "intx checksum256ToValue", totals, []( const auto& t ) {
+      return eosio_evm::checksum256ToValue( t );
+   });
+   run( "evm_vote_weight (contract)", totals, []( const auto& t ) {
+      return eosiosystem::vote_math::evm_vote_weight( eosio_evm::checksum256ToValue( t ) );
+   });
+   run( "evm_vote_weight (baseline, from_string + div)", totals, []( const auto& t ) {
+      return evm_vote_weight_generic( t );
+   });
+   // the 21 producers of a Telos schedule, and the 125 of the largest schedule the protocol accepts
+   for( const size_t size : { size_t( 21 ), size_t( 125 ) } ) {
+      auto [metrics, lookups] = schedule_metrics( rng, size );
+      const std::string prefix = "metrics lookup, " + std::to_string( size ) + " producers";
+      run( ( prefix + " (contract)" ).c_str(), lookups, [&metrics = metrics]( uint64_t p ) {
+         return uint64_t( eosiosystem::find_by_bp_name( metrics, p )->missed_blocks_per_cycle );
+      });
+      run( ( prefix + " (baseline, linear)" ).c_str(), lookups, [&metrics = metrics]( uint64_t p ) {
+         return uint64_t( find_producer_metric_linear( metrics, p )->missed_blocks_per_cycle );
+      });
+   }
+   run( "rlp::encode EVM transaction", txs, []( const auto& tx ) {
+      return encode_tx( tx );
+   });
+   run( "rlp RLPValue tree encode EVM transaction", txs, []( const auto& tx ) {
+      return tree_encode( tx.nonce, uint256_t( 0 ), uint256_t( 100000 ), tx.to, uint256_t( 0 ), tx.data,
+                          uint8_t( 0 ), uint256_t( 0 ), uint256_t( 0 ) );
+   });
+   run( "rlp::view decode EVM transaction", encoded, []( const auto& e ) {
+      const rlp::view item( e.data(), e.size() );
+      return item[0].to_uint256() + uint256_t( item[5].payload_size() );
+   });
+   run( "rlp::decode EVM transaction", encoded, []( const auto& e ) {
+      const auto item = rlp::decode( std::vector<int8_t>( e.begin(), e.end() ) );
+      return uint64_t( item.values.size() + item.values[5].value.size() );
+   });
+
+   std::printf( "checksum %016llx\n", (unsigned long long)sink );
+   return 0;
+}
@@ -0,0 +1,40 @@
+// Host stand-in for the parts of the CDT used by libs/intx, libs/rlp, libs/eosio.evm and the vote kernels of
+// eosio.system, so that they can be built and timed natively. Only what the benchmarks need is provided.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace eosio {
+
+   // both overloads of the CDT, a literal message must not cost an allocation when the check passes
+   inline void check( bool pred, const char* msg ) {
+      if( !pred ) throw std::runtime_error( msg );
+   }
+
+   inline void check( bool pred, const std::string& msg ) {
+      if( !pred ) throw std::runtime_error( msg );
+   }
+
+   struct checksum256 {
+      std::array<uint8_t, 32> bytes{};
+
+      checksum256() = default;
+      explicit checksum256( const std::array<uint8_t, 32>& b ) : bytes( b ) {}
+
+      std::array<uint8_t, 32> extract_as_byte_array()const { return bytes; }
+
+      friend bool operator==( const checksum256& a, const checksum256& b ) { return a.bytes == b.bytes; }
+      friend bool operator!=( const checksum256& a, const checksum256& b ) { return a.bytes != b.bytes; }
+   };
+
+} // namespace eosio
@@ -11,6 +11,8 @@
 #include <eosio.system/exchange_state.hpp>
 #include <eosio.system/native.hpp>
 
+#include <algorithm>
+#include <array>
 #include <deque>
 #include <optional>
 #include <string>
@@ -120,12 +122,37 @@ namespace eosiosystem {
 
    typedef eosio::multi_index< "payments"_n, payment_info > payments_table;
 
+   // Fingerprint of a producer schedule: the number of producers and the sum of their mixed names, which
+   // does not depend on the order of the producers so schedules can be compared without sorting them.
+   struct schedule_fingerprint {
+     uint64_t                         hash = 0;
+     uint32_t                         size = 0;
+
+     void add( name producer ) {
+       uint64_t z = producer.value;   // splitmix64 finalizer
+       z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+       z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+       hash += z ^ (z >> 31);
+       ++size;
+     }
+
+     friend bool operator == ( const schedule_fingerprint& a, const schedule_fingerprint& b ) {
+       return a.hash == b.hash && a.size == b.size;
+     }
+
+     EOSLIB_SERIALIZE(schedule_fingerprint, (hash)(size))
+   };
+
    struct [[eosio::table("schedulemetr"), eosio::contract("eosio.system")]] schedule_metrics_state {
      name                             last_onblock_caller;
      int32_t                          block_counter_correction;
      std::vector<producer_metric>     producers_metric;
+     eosio::binary_extension<schedule_fingerprint> proposed_schedule; /// fingerprint of `producers_metric`
+     eosio::binary_extension<eosio::checksum256>   proposed_schedule_digest; /// digest of the last proposed authorities, in order
 
      uint64_t primary_key()const { return last_onblock_caller.value; }
+
+     EOSLIB_SERIALIZE(schedule_metrics_state, (last_onblock_caller)(block_counter_correction)(producers_metric)(proposed_schedule)(proposed_schedule_digest))
    };
 
    typedef eosio::singleton< "schedulemetr"_n, schedule_metrics_state > schedule_metrics_singleton;
@@ -158,6 +185,114 @@ namespace eosiosystem {
 
    typedef eosio::singleton< "payrate"_n, payrates > payrate_singleton;
 
+   // How long a TLOS price read from the delphi oracle is reused before it is read again
+   const uint32_t price_cache_window_sec = 6 * 3600;
+
+   // Last TLOS/USD average price read from the delphi oracle and the time it was read
+   struct [[eosio::table("pricecache"), eosio::contract("eosio.system")]] price_cache {
+      uint64_t     price = 0;
+      time_point   updated;
+
+      EOSLIB_SERIALIZE( price_cache, (price)(updated) )
+   };
+
+   typedef eosio::singleton< "pricecache"_n, price_cache > price_cache_singleton;
+
+   // Number of producer payments written per block by a payments snapshot
+   const uint32_t snapshot_payments_per_block = 12;
+
+   // Payments snapshot whose payments are still being written, the row only exists until the last one is:
+   // - `producers` the activated producers to pay, in rank order,
+   // - `next_index` the position in `producers` of the next producer to pay,
+   // - `share_value` the value of one pay multiplier unit,
+   // - `claim_time` the time the snapshot was taken.
+   struct [[eosio::table("snapshot"), eosio::contract("eosio.system")]] snapshot_state {
+      std::vector<name>  producers;
+      uint32_t           next_index = 0;
+      double             share_value = 0;
+      time_point         claim_time;
+
+      EOSLIB_SERIALIZE( snapshot_state, (producers)(next_index)(share_value)(claim_time) )
+   };
+
+   typedef eosio::singleton< "snapshot"_n, snapshot_state > snapshot_singleton;
+
+   // Vote weights are accounted in whole units (0.0001 TLOS of weighted stake), so that the producer totals and
+   // `total_producer_vote_weight` are sums of integers, exact in a double while they stay below 2^53. Totals
+   // accounted before whole units were introduced are migrated by a vote recalculation.
+   const double max_exact_vote_weight = 9007199254740992.0;
+
+   // Number of voters `onblock` recalculates per block while a vote recalculation is in progress
+   const uint32_t recalc_voters_per_block = 50;
+
+   // Progress of a vote recalculation, the row only exists while one is in progress:
+   // - `next_voter` the first voter that has not been recalculated yet,
+   // - `voters_processed` the number of voters recalculated so far,
+   // - `total_activated_stake` the activated stake of the voters recalculated so far,
+   // - `started` the time the recalculation started.
+   struct [[eosio::table("recalcstate"), eosio::contract("eosio.system")]] recalc_state {
+      name              next_voter;
+      uint64_t          voters_processed = 0;
+      int64_t           total_activated_stake = 0;
+      block_timestamp   started;
+
+      EOSLIB_SERIALIZE( recalc_state, (next_voter)(voters_processed)(total_activated_stake)(started) )
+   };
+
+   typedef eosio::singleton< "recalcstate"_n, recalc_state > recalc_state_singleton;
+
+   // Producer vote totals rebuilt by a vote recalculation, swapped into the producers table once it completes
+   struct [[eosio::table, eosio::contract("eosio.system")]] recalc_vote {
+      name     owner;
+      double   total_votes = 0;
+
+      uint64_t primary_key()const { return owner.value; }
+
+      EOSLIB_SERIALIZE( recalc_vote, (owner)(total_votes) )
+   };
+
+   typedef eosio::multi_index< "recalcvotes"_n, recalc_vote > recalc_votes_table;
+
+   // Progress of a `voteupdall` pass, the row only exists while one is in progress:
+   // - `next_voter` the first voter that has not been updated yet,
+   // - `voters_updated` the number of voters updated so far.
+   struct [[eosio::table("voteupdall"), eosio::contract("eosio.system")]] vote_update_state {
+      name              next_voter;
+      uint64_t          voters_updated = 0;
+
+      EOSLIB_SERIALIZE( vote_update_state, (next_voter)(voters_updated) )
+   };
+
+   typedef eosio::singleton< "voteupdall"_n, vote_update_state > vote_update_singleton;
+
+   // Write-back tracking for the singletons cached by `system_contract`. Every site that modifies the cached
+   // value marks it dirty, setters go through `update` so that setting the current value marks nothing, and
+   // `save` only writes the singletons that were marked, so actions that leave the state untouched skip both
+   // the serialization and the `db_update`.
+   template<typename T>
+   class tracked_state {
+      public:
+         void mark_dirty() { _dirty = true; }
+
+         // Assigns `value` to a field of the cached value, and only marks it dirty when the field changes
+         template<typename Field, typename Value>
+         void update( Field& field, const Value& value ) {
+            if( field == value ) return;
+            field = value;
+            _dirty = true;
+         }
+
+         template<typename Singleton>
+         void save( Singleton& table, const T& value, name payer ) {
+            if( !_dirty ) return;
+            table.set( value, payer );
+            _dirty = false;
+         }
+
+      private:
+         bool _dirty = false;
+   };
+
 
    enum class kick_type {
       REACHED_TRESHOLD = 1,
@@ -336,8 +471,6 @@ namespace eosiosystem {
              kick_penalty_hours = penalty;
            break;
          }
-         lifetime_missed_blocks += missed_blocks_per_rotation;
-         missed_blocks_per_rotation = 0;
          // print("\nblock producer: ", name{owner}, " was kicked.");
          deactivate();
       }
@@ -427,6 +560,36 @@ namespace eosiosystem {
       EOSLIB_SERIALIZE( producer_info2, (owner)(votepay_share)(last_votepay_share_update) )
    };
 
+   // TELOS BEGIN
+   // Producer counters, the block counters of a producer updated on every block:
+   // - `owner` the producer
+   // - `unpaid_blocks` the blocks produced since the last claim
+   // - `lifetime_produced_blocks` the blocks produced since registration
+   // - `missed_blocks_per_rotation` the blocks missed in the current rotation
+   // - `lifetime_missed_blocks` the blocks missed since registration
+   // They are kept apart from `producer_info` so that the per-block writes do not re-serialize the url, reasons
+   // and authority of the producer. Once a producer has a row here, it holds the current value of these counters
+   // and the same fields of `producer_info` are no longer updated, `getproducer` returns the merged row.
+   struct [[eosio::table, eosio::contract("eosio.system")]] producer_counters {
+      name        owner;
+      uint32_t    unpaid_blocks = 0;
+      uint32_t    lifetime_produced_blocks = 0;
+      uint32_t    missed_blocks_per_rotation = 0;
+      uint32_t    lifetime_missed_blocks = 0;
+
+      uint64_t primary_key()const { return owner.value; }
+
+      // counters part of `producer_info::kick`
+      void kick() {
+         lifetime_missed_blocks += missed_blocks_per_rotation;
+         missed_blocks_per_rotation = 0;
+      }
+
+      // explicit serialization macro is not necessary, used here only to improve compilation time
+      EOSLIB_SERIALIZE( producer_counters, (owner)(unpaid_blocks)(lifetime_produced_blocks)(missed_blocks_per_rotation)(lifetime_missed_blocks) )
+   };
+   // TELOS END
+
    // Voter info. Voter info stores information about the voter:
    // - `owner` the voter
    // - `proxy` the proxy set by the voter, if any
@@ -454,7 +617,12 @@ namespace eosiosystem {
 
       uint32_t            flags1 = 0;
       uint32_t            reserved2 = 0;
+      // TELOS BEGIN
+      // Total net and cpu weight this voter delegates, kept by `changebw` and `unstaketorex` so that the
+      // `staked` value can be refreshed without walking the voter's `delband` scope. It holds no symbol until
+      // the first change to the voter's delegations after the upgrade, see `has_delegated_stake`.
       eosio::asset        reserved3;
+      // TELOS END
 
       // TELOS BEGIN
       eosio::binary_extension<uint64_t> self_stake_boost = 0;
@@ -462,6 +630,10 @@ namespace eosiosystem {
 
       uint64_t primary_key()const { return owner.value; }
 
+      // TELOS BEGIN
+      bool has_delegated_stake( const symbol& core )const { return reserved3.symbol == core; }
+      // TELOS END
+
       enum class flags1_fields : uint32_t {
          ram_managed = 1,
          net_managed = 2,
@@ -530,13 +702,50 @@ namespace eosiosystem {
                              > evm_votes_table;
    // TELOS END
 
+   // TELOS BEGIN
+   // EVM slot keys. EVM slot keys store the keys of the storage slots of a bp in the EVM voting contract:
+   // - `bp` the bp name
+   // - `vote_key` the key of the slot holding the total vote of the bp
+   // - `status_key` the key of the slot holding the status of the bp
+   struct [[eosio::table, eosio::contract("eosio.system")]] evm_slot_keys {
+      eosio::name         bp;         /// bp name
+      eosio::checksum256  vote_key;   /// keccak of the bp name and the vote storage slot
+      eosio::checksum256  status_key; /// keccak of the bp name and the status storage slot
+
+      uint64_t primary_key()const { return bp.value; }
+
+      // explicit serialization macro is not necessary, used here only to improve compilation time
+      EOSLIB_SERIALIZE( evm_slot_keys, (bp)(vote_key)(status_key) )
+   };
+
+   typedef eosio::multi_index< "evmslotkeys"_n, evm_slot_keys > evm_slot_keys_table;
+   // TELOS END
+
+   // TELOS BEGIN
+   // Progress of an `evmvotesync` pass, the row only exists while one is in progress:
+   // - `next_producer` the first producer that has not been synced yet,
+   // - `producers_synced` the number of producers synced so far.
+   struct [[eosio::table("evmvotesync"), eosio::contract("eosio.system")]] evm_vote_sync_state {
+      name              next_producer;
+      uint64_t          producers_synced = 0;
+
+      EOSLIB_SERIALIZE( evm_vote_sync_state, (next_producer)(producers_synced) )
+   };
+
+   typedef eosio::singleton< "evmvotesync"_n, evm_vote_sync_state > evm_vote_sync_singleton;
+   // TELOS END
+
    // TELOS BEGIN
    struct[[ eosio::table("votingconfig"), eosio::contract("eosio.system") ]] votingconfig {
       eosio::checksum160 evm_voting_contract;
       uint64_t decay_start_epoch;
       uint64_t decay_increase_yearly;
       uint64_t self_stake_boost_multiplier;
-      EOSLIB_SERIALIZE(votingconfig, (evm_voting_contract)(decay_start_epoch)(decay_increase_yearly)(self_stake_boost_multiplier))
+      // `Account::index` of the EVM voting contract and of the system account, resolved by `setvotecontr`
+      eosio::binary_extension<uint64_t> evm_voting_contract_index;
+      eosio::binary_extension<uint64_t> system_evm_index;
+      EOSLIB_SERIALIZE(votingconfig, (evm_voting_contract)(decay_start_epoch)(decay_increase_yearly)(self_stake_boost_multiplier)
+                                     (evm_voting_contract_index)(system_evm_index))
    };
    // TELOS END
 
@@ -544,12 +753,76 @@ namespace eosiosystem {
    typedef eosio::singleton< "votingconfig"_n, votingconfig > votingconfig_singleton;
    // TELOS END
 
+   // TELOS BEGIN
+   // Change of the votes of one producer, `from_new_set` tells whether the producer is part of the new votes
+   struct producer_vote_delta {
+      name     producer;
+      double   delta = 0;
+      bool     from_new_set = false;
+   };
+
+   // Producer vote deltas of a vote change, in producer name order. The previous and the new producer lists are
+   // sorted and hold at most 30 producers each, so they are merged in a single pass into a fixed buffer that
+   // holds their union without any heap allocation.
+   class producer_vote_deltas {
+      public:
+         static constexpr size_t max_deltas = 2 * 30;
+
+         producer_vote_deltas() = default;
+
+         // Subtracts `old_weight` from the `old_producers` and adds `new_weight` to the `new_producers`
+         producer_vote_deltas( const std::vector<name>& old_producers, double old_weight,
+                               const std::vector<name>& new_producers, double new_weight ) {
+            auto old_itr = old_producers.begin();
+            auto new_itr = new_producers.begin();
+            while( old_itr != old_producers.end() || new_itr != new_producers.end() ) {
+               if( new_itr == new_producers.end() || ( old_itr != old_producers.end() && *old_itr < *new_itr ) ) {
+                  push_back( *old_itr++, -old_weight, false );
+               } else if( old_itr == old_producers.end() || *new_itr < *old_itr ) {
+                  push_back( *new_itr++, new_weight, true );
+               } else {
+                  push_back( *new_itr++, new_weight - old_weight, true );
+                  ++old_itr;
+               }
+            }
+         }
+
+         // Appends the delta of a producer, producers must be appended in ascending name order
+         void push_back( const name& producer, double delta, bool from_new_set ) {
+            eosio::check( _size < max_deltas, "too many producer vote deltas" );
+            eosio::check( _size == 0 || _deltas[_size - 1].producer < producer, "producer vote deltas must be unique and sorted" );
+            _deltas[_size++] = producer_vote_delta{ producer, delta, from_new_set };
+         }
+
+         // Adds to the delta of a producer already part of the deltas
+         void add( const name& producer, double delta ) {
+            auto itr = std::lower_bound( begin(), end(), producer, []( const producer_vote_delta& d, const name& p ) {
+               return d.producer < p;
+            });
+            eosio::check( itr != end() && itr->producer == producer, "producer vote delta not found" );
+            _deltas[itr - begin()].delta += delta;
+         }
+
+         const producer_vote_delta* begin()const { return _deltas.data(); }
+         const producer_vote_delta* end()const   { return _deltas.data() + _size; }
+         size_t size()const                      { return _size; }
+
+      private:
+         std::array<producer_vote_delta, max_deltas> _deltas;
+         size_t                                      _size = 0;
+   };
+   // TELOS END
+
    typedef eosio::multi_index< "producers"_n, producer_info,
                                indexed_by<"prototalvote"_n, const_mem_fun<producer_info, double, &producer_info::by_votes>  >
                              > producers_table;
 
    typedef eosio::multi_index< "producers2"_n, producer_info2 > producers_table2;
 
+   // TELOS BEGIN
+   typedef eosio::multi_index< "prodcounters"_n, producer_counters > producer_counters_table;
+   // TELOS END
+
 
    typedef eosio::singleton< "global"_n, eosio_global_state >   global_state_singleton;
 
@@ -927,9 +1200,33 @@ namespace eosiosystem {
          payrate_singleton           _payrate;
          payrates                    _gpayrate;
          payments_table              _payments;
+         producer_counters_table     _producer_counters;
          evm_votes_table             _evm_votes;
          votingconfig_singleton      _voting_config;
          votingconfig                _gvoting_config;
+         recalc_state_singleton      _recalc;
+         std::optional<recalc_state> _grecalc;   // the vote recalculation in progress, if any
+
+         tracked_state<eosio_global_state>      _gstate_tracker;
+         tracked_state<eosio_global_state2>     _gstate2_tracker;
+         tracked_state<eosio_global_state3>     _gstate3_tracker;
+         tracked_state<eosio_global_state4>     _gstate4_tracker;
+         tracked_state<schedule_metrics_state>  _gschedule_metrics_tracker;
+         tracked_state<rotation_state>          _grotation_tracker;
+         tracked_state<payrates>                _gpayrate_tracker;
+         tracked_state<votingconfig>            _gvoting_config_tracker;
+
+         // Vote decay multiplier computed by the current action, reused while its inputs are unchanged
+         struct decay_multiplier_memo {
+            uint32_t sec_since_epoch = 0;
+            uint64_t decay_start_epoch = 0;
+            uint64_t decay_increase_yearly = 0;
+            double   multiplier = 1;
+         };
+         std::optional<decay_multiplier_memo>   _decay_multiplier_memo;
+
+         // Producer vote deltas accumulated by a vote update batch, by producer, written at the end of the batch
+         std::optional<std::vector<producer_vote_delta>> _producer_votes_batch;
          // TELOS END
 
       public:
@@ -1711,9 +2008,81 @@ namespace eosiosystem {
          [[eosio::action]]
          void setbpevmstat( eosio::name bp );
 
+         /**
+          * EVM vote sync action, reads the EVM vote of the next `max` producers and updates the ones whose
+          * vote changed, resuming from where the previous call stopped. A pass over all the producers starts
+          * again once the last one is synced. Producers without an EVM vote are skipped, and so are inactive
+          * producers without a counted EVM vote.
+          *
+          * @param max - the maximum number of producers to sync.
+          */
+         [[eosio::action]]
+         void evmvotesync( uint16_t max );
+
          [[eosio::action]]
          void setselfstake( uint64_t self_stake_boost_multiplier );
 
+         /**
+          * Recalculate votes action, recalculates the vote weight of up to `max` voters. The producer totals
+          * are rebuilt aside and replace the current ones once every voter has been recalculated.
+          * `onblock` advances a recalculation in progress on its own, this action lets anyone speed it up.
+          * Starting a new recalculation requires the authority of the system account.
+          *
+          * @param user - the account paying for the execution,
+          * @param max - the maximum number of voters to recalculate.
+          */
+         [[eosio::action]]
+         void recalcvotes( const name& user, uint16_t max );
+
+         /**
+          * Migrate counters action, moves the block counters of up to `max` producers that do not have a
+          * `prodcounters` row yet out of the producers table. Producers that are not migrated by this action
+          * are migrated the first time one of their counters changes.
+          *
+          * @param max - the maximum number of producers to migrate.
+          */
+         [[eosio::action]]
+         void migcounters( uint16_t max );
+
+         /**
+          * Get producer action, returns the `producer_info` row of `owner` with its block counters taken from
+          * the `prodcounters` table, as the producers table used to hold them.
+          *
+          * @param owner - the producer to return.
+          */
+         [[eosio::action]]
+         producer_info getproducer( const name& owner );
+
+         /**
+          * Vote update batch action, updates the `staked` value and the vote weight of each of `voters` as
+          * `voteupdate` does, without refreshing their REX balances. The producer rows are written once per
+          * batch, however many of the voters vote for them.
+          *
+          * @param voters - the voters to update.
+          */
+         [[eosio::action]]
+         void voteupdbatch( const std::vector<name>& voters );
+
+         /**
+          * Vote update all action, updates the next `max` voters as `voteupdbatch` does, resuming from where
+          * the previous call stopped. A pass over all the voters starts again once the last one is updated.
+          *
+          * @param max - the maximum number of voters to update.
+          */
+         [[eosio::action]]
+         void voteupdall( uint16_t max );
+
+         /**
+          * Audit delegated stake action, checks the delegated stake total kept in the `voters` row of
+          * `account` against its `delband` rows. A total that is not kept yet is initialized from them.
+          *
+          * @param account - the account whose delegations are audited.
+          *
+          * @pre `account` must have a row in the voters table
+          */
+         [[eosio::action]]
+         void auditdeleg( const name& account );
+
          using unregreason_action = eosio::action_wrapper<"unregreason"_n, &system_contract::unregreason>;
          using votebpout_action = eosio::action_wrapper<"votebpout"_n, &system_contract::votebpout>;
          using setpayrates_action = eosio::action_wrapper<"setpayrates"_n, &system_contract::setpayrates>;
@@ -1723,7 +2092,14 @@ namespace eosiosystem {
          using setvotecontr_action = eosio::action_wrapper<"setvotecontr"_n, &system_contract::setvotecontr>;
          using getevmvote_action = eosio::action_wrapper<"getevmvote"_n, &system_contract::getevmvote>;
          using setbpevmstat_action = eosio::action_wrapper<"setbpevmstat"_n, &system_contract::setbpevmstat>;
+         using evmvotesync_action = eosio::action_wrapper<"evmvotesync"_n, &system_contract::evmvotesync>;
          using setselfstake_action = eosio::action_wrapper<"setselfstake"_n, &system_contract::setselfstake>;
+         using recalcvotes_action = eosio::action_wrapper<"recalcvotes"_n, &system_contract::recalcvotes>;
+         using migcounters_action = eosio::action_wrapper<"migcounters"_n, &system_contract::migcounters>;
+         using getproducer_action = eosio::action_wrapper<"getproducer"_n, &system_contract::getproducer>;
+         using voteupdbatch_action = eosio::action_wrapper<"voteupdbatch"_n, &system_contract::voteupdbatch>;
+         using voteupdall_action = eosio::action_wrapper<"voteupdall"_n, &system_contract::voteupdall>;
+         using auditdeleg_action = eosio::action_wrapper<"auditdeleg"_n, &system_contract::auditdeleg>;
          // TELOS END
 
       private:
@@ -1839,16 +2215,43 @@ namespace eosiosystem {
          // TELOS BEGIN
          // defined in producer_pay.cpp
          void claimrewards_snapshot();
+         void continue_claimrewards_snapshot( snapshot_singleton& snapshot_table );
+         bool write_snapshot_payments( snapshot_state& snapshot );
          uint64_t get_telos_average_price();
+         uint64_t read_telos_average_price();
+         const producer_counters& get_producer_counters( const producer_info& prod );
+
+         template<typename Lambda>
+         void modify_producer_counters( const producer_info& prod, Lambda&& updater ) {
+            _producer_counters.modify( get_producer_counters( prod ), same_payer, std::forward<Lambda>( updater ) );
+         }
 
          double inverse_vote_weight(double staked, double amountVotedProducers);
          double decay_vote_weight_multiplier(double weighted_vote);
-         double apply_decay_multiplier(double weighted_vote, uint32_t sec_since_epoch, uint64_t decay_start_epoch, uint64_t decay_increase_yearly);
-         double uint256_to_double(uint256 value);
+         double whole_vote_weight(double weight);
+         double self_stake_boost_weight(uint64_t self_stake_boost, double weight);
+         void add_producer_votes(producer_info& prod, double delta);
+         void apply_producer_vote_deltas( const producer_vote_deltas& deltas, bool voting, bool recalculated );
+         void write_producer_votes_batch();
+         void update_voter_staked( const voter_info& voter );
+         int64_t sum_delegated_stake( const name& owner );
+         void add_delegated_stake( const name& owner, int64_t delta );
+         void update_voter_batched( const voter_info& voter );
          void recalculate_votes();
+         void start_vote_recalculation();
+         void process_vote_recalculation( uint32_t max );
+         int64_t recalculate_voter( const voter_info& voter );
+         bool is_vote_recalculated( const name& voter );
+         void update_recalc_votes( const name& producer, double delta );
+
+         // defined in eosio.system.cpp
+         uint64_t evm_vote_weight( const eosio::checksum256& total_vote );
+         evm_slot_keys get_evm_slot_keys( const producer_info& prod );
 
          //defined in system_kick.cpp
          bool crossed_missed_blocks_threshold(uint32_t amountBlocksMissed, uint32_t schedule_size);
+         producer_metric* find_producer_metric(name producer);
+         void sort_schedule_metrics();
          void reset_schedule_metrics(name producer);
          void update_producer_missed_blocks(name producer);
          bool is_new_schedule_activated(name active_schedule[], uint32_t size);
@@ -1859,9 +2262,9 @@ namespace eosiosystem {
          void set_bps_rotation(name bpOut, name sbpIn);
          void update_rotation_time(block_timestamp block_time);
          void update_missed_blocks_per_rotation();
-         void restart_missed_blocks_per_rotation(std::vector<producer_location_pair> prods);
+         void restart_missed_blocks_per_rotation(const std::vector<producer_location_pair>& prods);
          bool is_in_range(int32_t index, int32_t low_bound, int32_t up_bound);
-         std::vector<producer_location_pair> check_rotation_state(std::vector<producer_location_pair> producers, block_timestamp block_time);
+         void check_rotation_state(std::vector<producer_location_pair>& producers, block_timestamp block_time);
          // TELOS END
    };
 
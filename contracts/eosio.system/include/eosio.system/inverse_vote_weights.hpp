@@ -0,0 +1,27 @@
+#pragma once
+
+#include <array>
+
+namespace eosiosystem {
+
+   // Weights of the inverse weight voting by number of voted producers n, from 0 to 30:
+   // (sin(M_PI * n / 30 - M_PI_2) + 1.0) / 2.0, and 0 when no producer is voted.
+   // The sine is evaluated once, the results are kept as exact hexadecimal literals so that
+   // the contract does a lookup instead of a software emulated sine on every vote. The reference
+   // is the sine of the CDT libm the contract used: the inverse_vote_weight_table test compares
+   // every entry bit for bit with the weights the vote_weights_tester contract computes in WASM, and
+   // inverse_vote_weights_tests with a native port of that sine.
+   inline constexpr std::array<double, 31> inverse_vote_weights = {
+      0x0p+0, 0x1.6703583cc1d00p-9, 0x1.66079b0bff020p-7, 0x1.90f1ecbbab010p-6,
+      0x1.621e288040358p-5, 0x1.126145e9ecd54p-4, 0x1.8722191a02d60p-4, 0x1.07050af98827ep-3,
+      0x1.52cf6d23be850p-3, 0x1.a61b9f7154b44p-3, 0x1.0000000000000p-2, 0x1.2fc036f7cf296p-2,
+      0x1.61c8864680b58p-2, 0x1.958c994ef69c4p-2, 0x1.ca7b3ec987513p-2, 0x1.0000000000000p-1,
+      0x1.1ac2609b3c576p-1, 0x1.3539b35884b1ep-1, 0x1.4f1bbcdcbfa54p-1, 0x1.681fe484186b4p-1,
+      0x1.7ffffffffffffp-1, 0x1.96791823aad2fp-1, 0x1.ab4c24b7105ebp-1, 0x1.be3ebd419df62p-1,
+      0x1.cf1bbcdcbfa54p-1, 0x1.ddb3d742c2656p-1, 0x1.e9de1d77fbfcbp-1, 0x1.f378709a22a80p-1,
+      0x1.fa67e193d0040p-1, 0x1.fe98fca7c33e3p-1, 0x1.0000000000000p+0
+   };
+
+   static_assert( inverse_vote_weights[0] == 0.0 && inverse_vote_weights[15] == 0.5 && inverse_vote_weights[30] == 1.0 );
+
+} /// namespace eosiosystem
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace eosiosystem {
+
+   // Order in which the producers missing blocks are kicked: the most missed blocks first, then the least
+   // voted first. `Rank` has `missed_blocks_per_rotation` and `total_votes` members.
+   struct kick_order {
+      template<typename Rank>
+      bool operator()( const Rank& p1, const Rank& p2 ) const {
+         if( p1.missed_blocks_per_rotation != p2.missed_blocks_per_rotation )
+            return p1.missed_blocks_per_rotation > p2.missed_blocks_per_rotation;
+         return p1.total_votes < p2.total_votes;
+      }
+   };
+
+   // Moves the first `max_kick` producers of the kick order to the front of `ranks`, in that order, and returns
+   // the end of that prefix. At most `max_kick` producers are kicked, so the rest is left unordered. Kept free
+   // of the CDT so that the unit tests can compare it with a full sort.
+   template<typename Rank>
+   typename std::vector<Rank>::iterator rank_kick_candidates( std::vector<Rank>& ranks, size_t max_kick ) {
+      const auto ranked_end = ranks.begin() + std::min( max_kick, ranks.size() );
+      std::partial_sort( ranks.begin(), ranked_end, ranks.end(), kick_order{} );
+      return ranked_end;
+   }
+
+} /// namespace eosiosystem
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+namespace eosiosystem {
+
+   // Element of `items` whose `bp_name` is `producer`, nullptr when there is none. `items` must be sorted
+   // by `bp_name`, as the schedule metrics are. Kept free of the CDT so that the native benchmarks time
+   // the lookup the contract does on every block.
+   template<typename Item, typename Name>
+   Item* find_by_bp_name( std::vector<Item>& items, const Name& producer ) {
+      auto it = std::lower_bound( items.begin(), items.end(), producer, []( const Item& item, const Name& p ) {
+         return item.bp_name < p;
+      });
+      return it != items.end() && it->bp_name == producer ? &*it : nullptr;
+   }
+
+} /// namespace eosiosystem
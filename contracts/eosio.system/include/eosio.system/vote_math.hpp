@@ -0,0 +1,85 @@
+#pragma once
+
+#include <intx/intx.hpp>
+
+#include <cstdint>
+#include <optional>
+
+namespace eosiosystem { namespace vote_math {
+
+   // Integer and floating point kernels of the vote weights. They only depend on intx, so that the native
+   // benchmarks and unit tests run the same code as the contract. As for intx, `eosio::check` must be
+   // declared before this header is included.
+
+   constexpr uint64_t seconds_per_year    = 31'536'000ULL;                  // 365 d
+   constexpr uint64_t decay_precision_u64 = 1'000'000'000'000'000'000ULL;   // 1e18
+   constexpr uint64_t percent_denominator = 100ULL;                         // 100 %
+   constexpr double   two64               = 18446744073709551616.0;         // 2⁶⁴ (exact)
+
+   // 256-bit → double without __floatuntitf
+   inline double uint256_to_double( const intx::uint256& x ) {
+      const uint64_t* w = intx::as_words(x);        // little-endian 4×u64
+      double d = 0.0;
+      for (int i = 3; i >= 0; --i)                  // most-sig → least-sig
+         d = d * two64 + static_cast<double>(w[i]);
+      return d;
+   }
+
+   // The decay multiplier computed in 128 bits, nothing when rate × t does not fit. The scaled rate always
+   // fits (< 2⁶⁴ × 1e16), and the steps and roundings are the ones of `decay_multiplier_256`.
+   inline std::optional<double> decay_multiplier_128( uint64_t seconds_of_decay, uint64_t decay_increase_yearly_pct ) {
+      using uint128 = unsigned __int128;
+      const uint128 yearly_rate_scaled =
+         uint128{decay_increase_yearly_pct} * decay_precision_u64 / percent_denominator;
+      if (seconds_of_decay != 0 && yearly_rate_scaled > ~uint128{0} / seconds_of_decay)
+         return {};
+
+      const uint128 decay_multiplier_fp =
+         decay_precision_u64 + (yearly_rate_scaled * seconds_of_decay) / seconds_per_year;
+      // same rounding steps as uint256_to_double on the two low words
+      const double d = static_cast<double>(uint64_t(decay_multiplier_fp >> 64)) * two64
+                     + static_cast<double>(uint64_t(decay_multiplier_fp));
+      return d / static_cast<double>(decay_precision_u64);
+   }
+
+   // The decay multiplier computed in 256 bits, for any rate and duration
+   inline double decay_multiplier_256( uint64_t seconds_of_decay, uint64_t decay_increase_yearly_pct ) {
+      using intx::operator"" _u256;
+      constexpr intx::uint256 decay_precision = 1000000000000000000_u256;   // folded at compile time
+      // reciprocals of the constant divisors, computed at compile time
+      constexpr auto percent_divisor = intx::make_divisor(percent_denominator);
+      constexpr auto year_divisor    = intx::make_divisor(seconds_per_year);
+
+      /* 1 ▸ percent → 1 × 10¹⁸ fixed-point (≤ 1e20, well inside 256 bits) */
+      const intx::uint256 yearly_rate_scaled =
+         intx::uint256{decay_increase_yearly_pct} * decay_precision / percent_divisor;
+
+      /* 2 ▸ increment = rate × t / year (still fixed-point) */
+      const intx::uint256 increment_fp =
+         (yearly_rate_scaled * intx::uint256{seconds_of_decay}) / year_divisor;
+
+      const intx::uint256 decay_multiplier_fp = decay_precision + increment_fp;
+
+      /* 3 ▸ one final cast to IEEE-754 */
+      return uint256_to_double(decay_multiplier_fp) / uint256_to_double(decay_precision);
+   }
+
+   // Multiplier of the vote weights `sec_since_epoch` seconds after the epoch, 1 before the decay starts
+   inline double decay_multiplier( uint32_t sec_since_epoch, uint64_t decay_start_epoch, uint64_t decay_increase_yearly_pct ) {
+      if (decay_start_epoch == 0 || sec_since_epoch <= decay_start_epoch)
+         return 1.0;
+
+      const uint64_t seconds_of_decay = sec_since_epoch - decay_start_epoch;
+      if (const auto multiplier = decay_multiplier_128(seconds_of_decay, decay_increase_yearly_pct))
+         return *multiplier;
+      return decay_multiplier_256(seconds_of_decay, decay_increase_yearly_pct);
+   }
+
+   // Vote weight of an EVM vote total in wei, in whole units of 1e14 wei
+   inline uint64_t evm_vote_weight( const intx::uint256& total_vote ) {
+      // the reciprocal of 1e14 is computed at compile time, the division is a few multiplications
+      static constexpr auto ten_power_14 = intx::make_divisor(100000000000000ULL);
+      return (total_vote / ten_power_14).lo.lo;
+   }
+
+} } /// namespace eosiosystem::vote_math
@@ -78,6 +78,7 @@ namespace eosiosystem {
 
       _gstate.total_ram_bytes_reserved += uint64_t(bytes_out);
       _gstate.total_ram_stake          += quant_after_fee.amount;
+      _gstate_tracker.mark_dirty();
 
       user_resources_table  userres( get_self(), receiver.value );
       auto res_itr = userres.find( receiver.value );
@@ -130,6 +131,7 @@ namespace eosiosystem {
 
       _gstate.total_ram_bytes_reserved -= static_cast<decltype(_gstate.total_ram_bytes_reserved)>(bytes); // bytes > 0 is asserted above
       _gstate.total_ram_stake          -= tokens_out.amount;
+      _gstate_tracker.mark_dirty();
 
       //// this shouldn't happen, but just in case it does we should prevent it
       check( _gstate.total_ram_stake >= 0, "error, attempt to unstake more tokens than previously staked" );
@@ -345,6 +347,9 @@ namespace eosiosystem {
 
       vote_stake_updater( from );
       update_voting_power( from, stake_net_delta + stake_cpu_delta );
+      // TELOS BEGIN
+      add_delegated_stake( from, (stake_net_delta + stake_cpu_delta).amount );
+      // TELOS END
    }
 
    void system_contract::update_voting_power( const name& voter, const asset& total_update )
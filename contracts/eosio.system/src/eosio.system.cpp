@@ -11,6 +11,7 @@
 #include <intx/intx.hpp>
 #include <intx/base.hpp>
 #include <rlp/rlp.hpp>
+#include <eosio.system/vote_math.hpp>
 #include <limits>
 // TELOS END
 #include <cmath>
@@ -36,6 +37,38 @@ namespace eosiosystem {
    }
    // TELOS END
 
+   // TELOS BEGIN - Lookups of the EVM accounts used by EVM voting
+   namespace {
+      // `Account::index` of the EVM voting contract, by primary key once `setvotecontr` resolved it
+      uint64_t find_evm_voting_contract_index( const eosio_evm::account_table& accounts, const votingconfig& config ) {
+         if (config.evm_voting_contract_index.has_value()) {
+            auto itr = accounts.find(config.evm_voting_contract_index.value());
+            if (itr != accounts.end() && itr->address == config.evm_voting_contract) {
+               return itr->index;
+            }
+         }
+         auto accounts_byaddress = accounts.get_index<eosio::name("byaddress")>();
+         auto itr = accounts_byaddress.find(eosio_evm::Account::pad160(config.evm_voting_contract));
+         eosio::check(itr != accounts_byaddress.end(), "EVM voting contract not found");
+         return itr->index;
+      }
+
+      // EVM account of the system account, by primary key once `setvotecontr` resolved it
+      const eosio_evm::Account& find_system_evm_account( const eosio_evm::account_table& accounts, const votingconfig& config, name self ) {
+         if (config.system_evm_index.has_value()) {
+            auto itr = accounts.find(config.system_evm_index.value());
+            if (itr != accounts.end() && itr->account == self) {
+               return *itr;
+            }
+         }
+         auto accounts_byaccount = accounts.get_index<eosio::name("byaccount")>();
+         auto itr = accounts_byaccount.find(self.value);
+         eosio::check(itr != accounts_byaccount.end(), "eosio EVM address not found");
+         return *itr;
+      }
+   }
+   // TELOS END
+
    double get_continuous_rate(int64_t annual_rate) {
       return std::log1p(double(annual_rate)/double(100*inflation_precision));
    }
@@ -61,8 +94,10 @@ namespace eosiosystem {
     _rotation(_self, _self.value),
     _payrate(_self, _self.value),
     _payments(_self, _self.value),
+    _producer_counters(_self, _self.value),
     _evm_votes(_self, _self.value),
-    _voting_config(_self, _self.value)
+    _voting_config(_self, _self.value),
+    _recalc(_self, _self.value)
     // TELOS END
    {
       _gstate  = _global.exists() ? _global.get() : get_default_parameters();
@@ -74,6 +109,13 @@ namespace eosiosystem {
       _grotation = _rotation.get_or_create(_self, rotation_state{ name(0), name(0), 21, 75, block_timestamp(), block_timestamp() });
       _gpayrate = _payrate.get_or_create(_self, payrates{ max_bpay_rate, max_worker_monthly_amount });
       _gvoting_config = _voting_config.get_or_create(_self, votingconfig{ eosio::checksum160(), 0, 0, 0 });
+      if( _recalc.exists() ) _grecalc = _recalc.get();
+
+      // singletons that do not exist yet are written with their defaults by the destructor
+      if( !_global.exists() )  _gstate_tracker.mark_dirty();
+      if( !_global2.exists() ) _gstate2_tracker.mark_dirty();
+      if( !_global3.exists() ) _gstate3_tracker.mark_dirty();
+      if( !_global4.exists() ) _gstate4_tracker.mark_dirty();
       // TELOS END
    }
 
@@ -97,15 +139,15 @@ namespace eosiosystem {
    }
 
    system_contract::~system_contract() {
-      _global.set( _gstate, get_self() );
-      _global2.set( _gstate2, get_self() );
-      _global3.set( _gstate3, get_self() );
-      _global4.set( _gstate4, get_self() );
       // TELOS BEGIN
-      _schedule_metrics.set(_gschedule_metrics, _self);
-      _rotation.set(_grotation, _self);
-      _payrate.set(_gpayrate, _self);
-      _voting_config.set(_gvoting_config, _self);
+      _gstate_tracker.save( _global, _gstate, get_self() );
+      _gstate2_tracker.save( _global2, _gstate2, get_self() );
+      _gstate3_tracker.save( _global3, _gstate3, get_self() );
+      _gstate4_tracker.save( _global4, _gstate4, get_self() );
+      _gschedule_metrics_tracker.save( _schedule_metrics, _gschedule_metrics, _self );
+      _grotation_tracker.save( _rotation, _grotation, _self );
+      _gpayrate_tracker.save( _payrate, _gpayrate, _self );
+      _gvoting_config_tracker.save( _voting_config, _gvoting_config, _self );
       // TELOS END
    }
 
@@ -126,7 +168,7 @@ namespace eosiosystem {
          m.base.balance.amount += delta;
       });
 
-      _gstate.max_ram_size = max_ram_size;
+      _gstate_tracker.update( _gstate.max_ram_size, max_ram_size );
    }
 
    void system_contract::update_ram_supply() {
@@ -145,13 +187,15 @@ namespace eosiosystem {
          m.base.balance.amount += new_ram;
       });
       _gstate2.last_ram_increase = cbt;
+      _gstate_tracker.mark_dirty();
+      _gstate2_tracker.mark_dirty();
    }
 
    void system_contract::setramrate( uint16_t bytes_per_block ) {
       require_auth( get_self() );
 
       update_ram_supply();
-      _gstate2.new_ram_per_block = bytes_per_block;
+      _gstate2_tracker.update( _gstate2.new_ram_per_block, bytes_per_block );
    }
 
 #ifdef SYSTEM_BLOCKCHAIN_PARAMETERS
@@ -160,7 +204,12 @@ namespace eosiosystem {
 
    void system_contract::setparams( const blockchain_parameters_t& params ) {
       require_auth( get_self() );
-      (eosio::blockchain_parameters&)(_gstate) = params;
+      // the parameters have no equality operator, their serialized forms are compared instead
+      const eosio::blockchain_parameters& new_params = params;
+      if( eosio::pack( (const eosio::blockchain_parameters&)(_gstate) ) != eosio::pack( new_params ) ) {
+         (eosio::blockchain_parameters&)(_gstate) = new_params;
+         _gstate_tracker.mark_dirty();
+      }
       check( 3 <= _gstate.max_authority_depth, "max_authority_depth should be at least 3" );
 #ifndef SYSTEM_BLOCKCHAIN_PARAMETERS
       set_blockchain_parameters( params );
@@ -451,6 +500,7 @@ namespace eosiosystem {
       check( revision <= 1, // set upper bound to greatest revision supported in the code
              "specified revision is not yet supported by the code" );
       _gstate2.revision = revision;
+      _gstate2_tracker.mark_dirty();
    }
 
    void system_contract::setinflation( int64_t annual_rate, int64_t inflation_pay_factor, int64_t votepay_factor ) {
@@ -462,10 +512,9 @@ namespace eosiosystem {
       if ( votepay_factor < pay_factor_precision ) {
          check( false, "votepay_factor must not be less than " + std::to_string(pay_factor_precision) );
       }
-      _gstate4.continuous_rate      = get_continuous_rate(annual_rate);
-      _gstate4.inflation_pay_factor = inflation_pay_factor;
-      _gstate4.votepay_factor       = votepay_factor;
-      _global4.set( _gstate4, get_self() );
+      _gstate4_tracker.update( _gstate4.continuous_rate,      get_continuous_rate(annual_rate) );
+      _gstate4_tracker.update( _gstate4.inflation_pay_factor, inflation_pay_factor );
+      _gstate4_tracker.update( _gstate4.votepay_factor,       votepay_factor );
    }
 
    /**
@@ -567,14 +616,17 @@ namespace eosiosystem {
       _producers.modify(pitr, same_payer, [&](auto &p) {
         p.kick(kick_type::BPS_VOTING, penalty_hours);
       });
+      modify_producer_counters(*pitr, [&](auto &c) {
+        c.kick();
+      });
    }
 
    void system_contract::setpayrates(uint64_t bpay, uint64_t worker) {
       require_auth(_self);
       check(worker <= max_worker_monthly_amount, "WPS rate exceeds the max");
       check(bpay <= max_bpay_rate, "BPAY rate exceeds the max");
-      _gpayrate.bpay_rate = bpay;
-      _gpayrate.worker_amount = worker;
+      _gpayrate_tracker.update( _gpayrate.bpay_rate, bpay );
+      _gpayrate_tracker.update( _gpayrate.worker_amount, worker );
    }
 
    void system_contract::distviarex(name from, asset amount) {
@@ -593,8 +645,8 @@ namespace eosiosystem {
       // Validate decay_increase_yearly is within reasonable bounds (0-100%)
       eosio::check(decay_increase_yearly <= 100, "decay_increase_yearly must be <= 100 (100%)");
       
-      _gvoting_config.decay_start_epoch = decay_start_epoch;
-      _gvoting_config.decay_increase_yearly = decay_increase_yearly;
+      _gvoting_config_tracker.update( _gvoting_config.decay_start_epoch, decay_start_epoch );
+      _gvoting_config_tracker.update( _gvoting_config.decay_increase_yearly, decay_increase_yearly );
 
       // Create a EVM TX for to update the status of BP in EVM
       std::array<uint8_t, 68> tx_data{};
@@ -620,14 +672,12 @@ namespace eosiosystem {
       // Get eosio EVM address nonce
       eosio_evm::account_table account(evm_account, evm_account.value);
       std::array<uint8_t, 20> evm_voting_contract_address = _gvoting_config.evm_voting_contract.extract_as_byte_array();
-      auto accounts_byaccount = account.get_index<eosio::name("byaccount")>();
-      auto eosio_account = accounts_byaccount.find(get_self().value);
-      std::optional<eosio::checksum160> eosio_account_address = eosio_account->address;
-      eosio::check(eosio_account != accounts_byaccount.end(),"eosio EVM address not found");
+      const auto& eosio_account = find_system_evm_account(account, _gvoting_config, get_self());
+      std::optional<eosio::checksum160> eosio_account_address = eosio_account.address;
 
       // Encode EVM transaction
       auto tx_hex = rlp::encode(
-         uint256_t(eosio_account->nonce), // Nonce
+         uint256_t(eosio_account.nonce), // Nonce
          uint256_t(0), // Gas price
          uint256_t(evm_voting_constants::DEFAULT_GAS_LIMIT), // Gas limit
          evm_voting_contract_address, // To
@@ -649,6 +699,17 @@ namespace eosiosystem {
    void system_contract::setvotecontr( eosio::checksum160 contract ) {
       require_auth(_self);
       _gvoting_config.evm_voting_contract = contract;
+      _gvoting_config.evm_voting_contract_index.reset();
+      _gvoting_config.system_evm_index.reset();
+      _gvoting_config_tracker.mark_dirty();
+      if (contract == eosio::checksum160()) {
+         return;
+      }
+
+      // Resolve both EVM accounts once, later EVM voting actions find them by primary key
+      eosio_evm::account_table account(evm_account, evm_account.value);
+      _gvoting_config.evm_voting_contract_index = find_evm_voting_contract_index(account, _gvoting_config);
+      _gvoting_config.system_evm_index = find_system_evm_account(account, _gvoting_config, get_self()).index;
    }
 
    void system_contract::getevmvote( std::vector<eosio::name> bps ) {
@@ -661,43 +722,31 @@ namespace eosiosystem {
       }
 
       // Get the EVM voting contract
-      
       eosio_evm::account_table account(evm_account, evm_account.value);
-      auto accounts_byaddress = account.get_index<eosio::name("byaddress")>();
-      std::array<uint8_t, 20> evm_voting_contract_address = _gvoting_config.evm_voting_contract.extract_as_byte_array();
-      std::array<uint8_t, 32> evm_voting_contract_address_256{};
-      std::copy(evm_voting_contract_address.begin(), evm_voting_contract_address.end(), evm_voting_contract_address_256.begin() + 12);
-      auto evm_voting_account = accounts_byaddress.find(eosio::checksum256(evm_voting_contract_address_256));
-      eosio::check(evm_voting_account != accounts_byaddress.end(),"EVM voting contract not found");
-      
+      const uint64_t evm_voting_contract_index = find_evm_voting_contract_index(account, _gvoting_config);
+
       // Get the access to the state
-      eosio_evm::account_state_table accounts_states(evm_account, evm_voting_account->primary_key());
+      eosio_evm::account_state_table accounts_states(evm_account, evm_voting_contract_index);
       auto accounts_states_bykey = accounts_states.get_index<eosio::name("bykey")>();
 
       // Add a flag to make sure at least a single vote is changed
       bool is_changed = false;
 
+      // Vote changes of the BPs, applied once all the EVM votes are read
+      producer_vote_deltas evm_deltas;
+
       for (eosio::name bp : bps) {
 
-         // Access the vote of the BP in the EVM voting contract internal state
-         // Memory location: 32 bytes of zeros + 32 bytes with storage slot index at position 63
-         std::array<uint8_t, 64> vote_memory_location = {};
-         vote_memory_location[63] = evm_voting_constants::VOTE_STORAGE_SLOT;
-         std::array<uint8_t, 8> bp_name_bytes{};
-         for (size_t i = 0; i < 8; ++i) {
-            bp_name_bytes[7 - i] = static_cast<uint8_t>(bp.value >> (i * 8));
-         }
-         std::copy(std::begin(bp_name_bytes), std::end(bp_name_bytes), vote_memory_location.begin() + 24);
-         eosio::checksum256 vote_memory_location_key = eosio::keccak((char*)vote_memory_location.data(), 64);
-         
+         const auto pitr = _producers.find( bp.value );
+         eosio::check( pitr != _producers.end(), "BP not found" );
+
          // Get the total votes of the BP
-         auto total_votes_of_bp = accounts_states_bykey.find(vote_memory_location_key);
+         auto total_votes_of_bp = accounts_states_bykey.find(get_evm_slot_keys(*pitr).vote_key);
          eosio::check(total_votes_of_bp != accounts_states_bykey.end(), "BP vote not found in EVM state");
 
          // Search for the BP in the `evmvotes` table
          auto evmvotes_byname = _evm_votes.get_index<eosio::name("byname")>();
          auto evm_vote = evmvotes_byname.find(bp.value);
-         const uint256_t ten_power_14 = intx::from_string<uint256_t>("0x5af3107a4000");
 
          if (evm_vote == evmvotes_byname.end()) {
             // First time EVM vote
@@ -705,15 +754,8 @@ namespace eosiosystem {
             is_changed = true;
 
             // Apply the EVM votes of the BP
-            auto pitr = _producers.find( bp.value );
-            eosio::check( pitr != _producers.end(), "BP not found" );
-            _producers.modify( pitr, same_payer, [&]( auto& p ) {
-               uint256_t current_vote = eosio_evm::checksum256ToValue(total_votes_of_bp->value);
-               uint256_t current_vote_normalized = current_vote / ten_power_14; // Divide by 1e14
-               uint64_t current_vote_normalized_u64 = current_vote_normalized.lo.lo;
-               p.total_votes += double(current_vote_normalized_u64);
-               _gstate.total_producer_vote_weight += double(current_vote_normalized_u64);
-            });
+            uint64_t current_vote_normalized_u64 = evm_vote_weight(total_votes_of_bp->value);
+            evm_deltas.push_back( bp, double(current_vote_normalized_u64), false );
 
             // Add a new row to store the new BP vote data
             _evm_votes.emplace(_self, [&](auto &a) {
@@ -729,25 +771,11 @@ namespace eosiosystem {
             }            
 
             // Apply the EVM votes of the BP
-            auto pitr = _producers.find( bp.value );
-            eosio::check( pitr != _producers.end(), "BP not found" );
-            _producers.modify( pitr, same_payer, [&]( auto& p ) {
-               uint256_t previous_vote = eosio_evm::checksum256ToValue(evm_vote->total_vote);
-               uint256_t previous_vote_normalized = previous_vote / ten_power_14; // Divide by 1e14
-               uint64_t previous_vote_normalized_u64 = previous_vote_normalized.lo.lo;
-               uint256_t current_vote = eosio_evm::checksum256ToValue(total_votes_of_bp->value);
-               uint256_t current_vote_normalized = current_vote / ten_power_14; // Divide by 1e14
-               uint64_t current_vote_normalized_u64 = current_vote_normalized.lo.lo;
-               double vote_delta = double(current_vote_normalized_u64 - previous_vote_normalized_u64);
-               p.total_votes += vote_delta;
-               if ( p.total_votes < 0 ) {
-                  p.total_votes = 0;
-               }
-               _gstate.total_producer_vote_weight += vote_delta;
-               if ( _gstate.total_producer_vote_weight < 0 ) {
-                  _gstate.total_producer_vote_weight = 0;
-               }
-            });
+            uint64_t previous_vote_normalized_u64 = evm_vote_weight(evm_vote->total_vote);
+            uint64_t current_vote_normalized_u64 = evm_vote_weight(total_votes_of_bp->value);
+            // signed difference, a decreased EVM vote must not wrap around
+            double vote_delta = double(int64_t(current_vote_normalized_u64) - int64_t(previous_vote_normalized_u64));
+            evm_deltas.push_back( bp, vote_delta, false );
             
             // Apply the updated vote to the existing row
             evmvotes_byname.modify(evm_vote, same_payer, [&](auto& a) {
@@ -758,7 +786,116 @@ namespace eosiosystem {
       }  
 
       eosio::check(is_changed, "None of the BPs EVM votes has been changed");
+
+      // EVM votes are added to the recalculated totals when a recalculation completes, they are not mirrored
+      apply_producer_vote_deltas( evm_deltas, false, false );
+      if ( _gstate.total_producer_vote_weight < 0 ) {
+         _gstate.total_producer_vote_weight = 0;
+         _gstate_tracker.mark_dirty();
+      }
+   }
+
+   void system_contract::evmvotesync( uint16_t max ) {
+
+      eosio::check(_gvoting_config.evm_voting_contract != eosio::checksum160(), "EVM voting contract not set");
+      eosio::check(max > 0, "max must be positive");
+
+      evm_vote_sync_singleton vote_sync(get_self(), get_self().value);
+      auto state = vote_sync.get_or_default();
+
+      // Get the access to the state of the EVM voting contract
+      eosio_evm::account_table account(evm_account, evm_account.value);
+      eosio_evm::account_state_table accounts_states(evm_account, find_evm_voting_contract_index(account, _gvoting_config));
+      auto accounts_states_bykey = accounts_states.get_index<eosio::name("bykey")>();
+
+      auto pitr = _producers.lower_bound(state.next_producer.value);
+      for (uint32_t processed = 0; pitr != _producers.end() && processed < max; ++pitr, ++processed) {
+         ++state.producers_synced;
+
+         // An inactive producer is only synced to update the EVM vote already counted for it, the others are
+         // skipped without reading the EVM state or computing their slot keys
+         auto evm_vote = _evm_votes.find(pitr->owner.value);
+         if (!pitr->active() && evm_vote == _evm_votes.end()) {
+            continue;
+         }
+
+         auto total_votes_of_bp = accounts_states_bykey.find(get_evm_slot_keys(*pitr).vote_key);
+         if (total_votes_of_bp == accounts_states_bykey.end()) {
+            continue;
+         }
+
+         // Only the BPs whose EVM vote changed have their rows written
+         uint64_t previous_vote_normalized_u64 = 0;
+         if (evm_vote == _evm_votes.end()) {
+            _evm_votes.emplace(_self, [&](auto &a) {
+               a.bp = pitr->owner;
+               a.total_vote = total_votes_of_bp->value;
+            });
+         } else if (evm_vote->total_vote != total_votes_of_bp->value) {
+            previous_vote_normalized_u64 = evm_vote_weight(evm_vote->total_vote);
+            _evm_votes.modify(evm_vote, same_payer, [&](auto& a) {
+               a.total_vote = total_votes_of_bp->value;
+            });
+         } else {
+            continue;
+         }
+
+         uint64_t current_vote_normalized_u64 = evm_vote_weight(total_votes_of_bp->value);
+         // signed difference, a decreased EVM vote must not wrap around
+         double vote_delta = double(int64_t(current_vote_normalized_u64) - int64_t(previous_vote_normalized_u64));
+         if (vote_delta != 0) {
+            _producers.modify(pitr, same_payer, [&](auto& p) {
+               add_producer_votes(p, vote_delta);
+            });
+         }
+      }
+      if ( _gstate.total_producer_vote_weight < 0 ) {
+         _gstate.total_producer_vote_weight = 0;
+         _gstate_tracker.mark_dirty();
+      }
+
+      if (pitr == _producers.end()) {
+         vote_sync.remove();
+      } else {
+         state.next_producer = pitr->owner;
+         vote_sync.set(state, get_self());
+      }
+   }
+
+   uint64_t system_contract::evm_vote_weight( const eosio::checksum256& total_vote ) {
+      return vote_math::evm_vote_weight(eosio_evm::checksum256ToValue(total_vote)); // Divide by 1e14
+   }
+
+   evm_slot_keys system_contract::get_evm_slot_keys( const producer_info& prod ) {
+      const name bp = prod.owner;
+      evm_slot_keys_table slot_keys(get_self(), get_self().value);
+      auto itr = slot_keys.find(bp.value);
+      if (itr != slot_keys.end()) {
+         return *itr;
+      }
+
+      // Memory location: 32 bytes of zeros + 32 bytes with storage slot index at position 63,
+      // with the BP name in the 8 bytes ending at position 31
+      std::array<uint8_t, 64> memory_location = {};
+      for (size_t i = 0; i < 8; ++i) {
+         memory_location[31 - i] = static_cast<uint8_t>(bp.value >> (i * 8));
+      }
+      evm_slot_keys keys{ bp };
+      memory_location[63] = evm_voting_constants::VOTE_STORAGE_SLOT;
+      keys.vote_key = eosio::keccak((char*)memory_location.data(), 64);
+      memory_location[63] = evm_voting_constants::STATUS_STORAGE_SLOT;
+      keys.status_key = eosio::keccak((char*)memory_location.data(), 64);
+
+      // The EVM voting actions are permissionless and reach every registered producer, only the keys of the
+      // active ones are kept at the system account's expense. The others are computed again when needed.
+      if (prod.active()) {
+         slot_keys.emplace(get_self(), [&](auto& k) {
+            k = keys;
+         });
+      }
+      return keys;
    }
+
    void system_contract::setbpevmstat( eosio::name bp ) {
 
       eosio::check(_gvoting_config.evm_voting_contract != eosio::checksum160(), "EVM voting contract not set");
@@ -768,30 +905,15 @@ namespace eosiosystem {
 
       // Get the EVM voting contract
       eosio_evm::account_table account(evm_account, evm_account.value);
-      auto accounts_byaddress = account.get_index<eosio::name("byaddress")>();
       std::array<uint8_t, 20> evm_voting_contract_address = _gvoting_config.evm_voting_contract.extract_as_byte_array();
-      std::array<uint8_t, 32> evm_voting_contract_address_256{};
-      std::copy(evm_voting_contract_address.begin(), evm_voting_contract_address.end(), evm_voting_contract_address_256.begin() + 12);
-      auto evm_voting_account = accounts_byaddress.find(eosio::checksum256(evm_voting_contract_address_256));
-      eosio::check(evm_voting_account != accounts_byaddress.end(),"EVM voting contract not found");
+      const uint64_t evm_voting_contract_index = find_evm_voting_contract_index(account, _gvoting_config);
 
       // Get the access to the state
-      eosio_evm::account_state_table accounts_states(evm_account, evm_voting_account->primary_key());
+      eosio_evm::account_state_table accounts_states(evm_account, evm_voting_contract_index);
       auto accounts_states_bykey = accounts_states.get_index<eosio::name("bykey")>();
 
-      // Access the status of the BP in the EVM voting contract internal state
-      // Memory location: 32 bytes of zeros + 32 bytes with storage slot index at position 63
-      std::array<uint8_t, 64> bp_status_location = {};
-      bp_status_location[63] = evm_voting_constants::STATUS_STORAGE_SLOT;
-      std::array<uint8_t, 8> bp_name_bytes{};
-      for (size_t i = 0; i < 8; ++i) {
-         bp_name_bytes[7 - i] = static_cast<uint8_t>(bp.value >> (i * 8));
-      }
-      std::copy(std::begin(bp_name_bytes), std::end(bp_name_bytes), bp_status_location.begin() + 24);
-      eosio::checksum256 bp_status_location_key = eosio::keccak((char*)bp_status_location.data(), 64);
-      
       // Get the status of the BP
-      auto status_of_bp = accounts_states_bykey.find(bp_status_location_key);
+      auto status_of_bp = accounts_states_bykey.find(get_evm_slot_keys(*pitr).status_key);
       eosio::check(status_of_bp != accounts_states_bykey.end(), "BP status not found in EVM state");
       // Get status of BP in EVM
       bool bp_status_in_evm = status_of_bp->value.extract_as_byte_array()[31];
@@ -812,16 +934,16 @@ namespace eosiosystem {
                    std::end(evm_voting_constants::UNREGISTER_BP_SELECTOR), 
                    tx_data.begin());
       }
-      std::copy(std::begin(bp_name_bytes), std::end(bp_name_bytes), tx_data.begin() + 28);
+      for (size_t i = 0; i < 8; ++i) {
+         tx_data[35 - i] = static_cast<uint8_t>(bp.value >> (i * 8));
+      }
       // Get eosio EVM address nonce
-      auto accounts_byaccount = account.get_index<eosio::name("byaccount")>();
-      auto eosio_account = accounts_byaccount.find(get_self().value);
-      std::optional<eosio::checksum160> eosio_account_address = eosio_account->address;
-      eosio::check(eosio_account != accounts_byaccount.end(),"eosio EVM address not found");
+      const auto& eosio_account = find_system_evm_account(account, _gvoting_config, get_self());
+      std::optional<eosio::checksum160> eosio_account_address = eosio_account.address;
 
       // Encode EVM transaction
       auto tx_hex = rlp::encode(
-         uint256_t(eosio_account->nonce), // Nonce
+         uint256_t(eosio_account.nonce), // Nonce
          uint256_t(0), // Gas price
          uint256_t(evm_voting_constants::DEFAULT_GAS_LIMIT), // Gas limit
          evm_voting_contract_address, // To
@@ -844,7 +966,7 @@ namespace eosiosystem {
    void system_contract::setselfstake( uint64_t self_stake_boost_multiplier ) {
       require_auth(_self);
       eosio::check(self_stake_boost_multiplier <= 1000, "self_stake_boost_multiplier must be <= 1000");
-      _gvoting_config.self_stake_boost_multiplier = self_stake_boost_multiplier;
+      _gvoting_config_tracker.update( _gvoting_config.self_stake_boost_multiplier, self_stake_boost_multiplier );
    }
    // TELOS END
 } /// eosio.system
@@ -38,6 +38,9 @@ namespace eosiosystem {
       /** until activation, no new rewards are paid */
       // TELOS BEGIN
       _gstate.block_num++;
+      // every onblock changes both, the later updates of this action are covered
+      _gstate_tracker.mark_dirty();
+      _gstate2_tracker.mark_dirty();
       if (_gstate.thresh_activated_stake_time == time_point()) {
           if(_gstate.block_num >= block_num_network_activation && _gstate.total_producer_vote_weight > 0) {
               _gstate.thresh_activated_stake_time = current_time_point();
@@ -64,10 +67,12 @@ namespace eosiosystem {
       auto prod = _producers.find( producer.value );
       if ( prod != _producers.end() ) {
          _gstate.total_unpaid_blocks++;
-         _producers.modify( prod, same_payer, [&](auto& p ) {
-               p.unpaid_blocks++;
-               p.lifetime_produced_blocks++;  // TELOS
+         // TELOS BEGIN
+         modify_producer_counters( *prod, [&](auto& c ) {
+               c.unpaid_blocks++;
+               c.lifetime_produced_blocks++;
          });
+         // TELOS END
       }
 
       recalculate_votes();  // TELOS
@@ -95,8 +100,11 @@ namespace eosiosystem {
          }
       }
       // TELOS BEGIN
-      //called once per day to set payments snapshot
-      if (_gstate.last_claimrewards + uint32_t(3600) <= timestamp.slot) { //172800 blocks in a day
+      //called once per day to set payments snapshot, its payments are then written over the next blocks
+      snapshot_singleton snapshot(get_self(), get_self().value);
+      if (snapshot.exists()) {
+          continue_claimrewards_snapshot(snapshot);
+      } else if (_gstate.last_claimrewards + uint32_t(3600) <= timestamp.slot) { //172800 blocks in a day
           claimrewards_snapshot();
           _gstate.last_claimrewards = timestamp.slot;
       }
@@ -245,33 +253,104 @@ namespace eosiosystem {
    }
 
    // TELOS BEGIN
-   uint64_t system_contract::get_telos_average_price() {
-      // Reads the delphi oracle TLOS/USD price
-      delphioracle::averagestable averages_table(delphi_oracle_account, "tlosusd"_n.value);
+   const producer_counters& system_contract::get_producer_counters( const producer_info& prod ) {
+      auto citr = _producer_counters.find( prod.owner.value );
+      if( citr == _producer_counters.end() ) {
+         // first change of a producer that was not migrated yet, take over the counters of its producers row
+         citr = _producer_counters.emplace( get_self(), [&]( auto& c ) {
+            c.owner                      = prod.owner;
+            c.unpaid_blocks              = prod.unpaid_blocks;
+            c.lifetime_produced_blocks   = prod.lifetime_produced_blocks;
+            c.missed_blocks_per_rotation = prod.missed_blocks_per_rotation;
+            c.lifetime_missed_blocks     = prod.lifetime_missed_blocks;
+         });
+      }
+      return *citr;
+   }
 
-      // Gets monthly average TLOS price
-      for (auto itr = averages_table.begin(); itr != averages_table.end(); ++itr) {
-         if (itr->type == delphioracle::averages::get_type(average_types::last_30_days)) {
-            return itr->value;
+   void system_contract::migcounters( uint16_t max ) {
+      require_auth( get_self() );
+      check( max > 0, "max must be positive" );
+
+      uint16_t migrated = 0;
+      for( auto pitr = _producers.begin(); pitr != _producers.end() && migrated < max; ++pitr ) {
+         if( _producer_counters.find( pitr->owner.value ) == _producer_counters.end() ) {
+            get_producer_counters( *pitr );
+            ++migrated;
          }
       }
+      check( migrated > 0, "all producers are already migrated" );
+   }
 
-      // Gets 14 days average if monthly average is not available
-      for (auto itr = averages_table.begin(); itr != averages_table.end(); ++itr) {
-         if (itr->type == delphioracle::averages::get_type(average_types::last_14_days)) {
-            return itr->value;
+   producer_info system_contract::getproducer( const name& owner ) {
+      producer_info prod = _producers.get( owner.value, "producer not found" );
+      auto citr = _producer_counters.find( owner.value );
+      if( citr != _producer_counters.end() ) {
+         prod.unpaid_blocks              = citr->unpaid_blocks;
+         prod.lifetime_produced_blocks   = citr->lifetime_produced_blocks;
+         prod.missed_blocks_per_rotation = citr->missed_blocks_per_rotation;
+         prod.lifetime_missed_blocks     = citr->lifetime_missed_blocks;
+      }
+      return prod;
+   }
+
+   uint64_t system_contract::get_telos_average_price() {
+      const auto now = current_time_point();
+
+      price_cache_singleton cache(get_self(), get_self().value);
+      if (cache.exists()) {
+         const auto cached = cache.get();
+         if (now < cached.updated + eosio::seconds(price_cache_window_sec)) {
+            return cached.price;
          }
       }
 
-      // Gets 7 days average if 14 days average is not available
-      for (auto itr = averages_table.begin(); itr != averages_table.end(); ++itr) {
-         if (itr->type == delphioracle::averages::get_type(average_types::last_7_days)) {
+      uint64_t price = read_telos_average_price();
+
+      // Returns smallest non zero value if no price is available, without caching it
+      if (price == 0) {
+         return 1;
+      }
+
+      cache.set(price_cache{ price, now }, get_self());
+      return price;
+   }
+
+   uint64_t system_contract::read_telos_average_price() {
+      // Reads the delphi oracle TLOS/USD price
+      delphioracle::averagestable averages_table(delphi_oracle_account, "tlosusd"_n.value);
+
+      // Monthly average TLOS price, then the 14 days and 7 days averages if it is not available
+      const uint8_t types[] = {
+         delphioracle::averages::get_type(average_types::last_30_days),
+         delphioracle::averages::get_type(average_types::last_14_days),
+         delphioracle::averages::get_type(average_types::last_7_days)
+      };
+
+#ifdef SYSTEM_DELPHIORACLE_TYPE_INDEX
+      auto averages_by_type = averages_table.get_index<"type"_n>();
+      for (auto type : types) {
+         auto itr = averages_by_type.find(type);
+         if (itr != averages_by_type.end()) {
             return itr->value;
          }
       }
-      
-      // Returns smallest non zero value if no price is available
-      return 1;
+      return 0;
+#else
+      // single pass keeping the first average of the most preferred type seen so far
+      size_t best = std::size(types);
+      uint64_t price = 0;
+      for (auto itr = averages_table.begin(); itr != averages_table.end() && best > 0; ++itr) {
+         for (size_t i = 0; i < best; ++i) {
+            if (itr->type == types[i]) {
+               best = i;
+               price = itr->value;
+               break;
+            }
+         }
+      }
+      return price;
+#endif
    }
    // TELOS END
 
@@ -335,22 +414,31 @@ namespace eosiosystem {
 
             _gstate.perblock_bucket += to_producers;
             _gstate.last_pervote_bucket_fill = ct;
+            _gstate_tracker.mark_dirty();
         }
 
         //sort producers table
         auto sortedprods = _producers.get_index<"prototalvote"_n>();
 
-        //calculate shares, based on MAX_PRODUCERS
-        uint32_t activecount = 0;
+        //rank the activated producers to pay, based on MAX_PRODUCERS
+        snapshot_state snapshot;
+        snapshot.claim_time = ct;
+        snapshot.producers.reserve(MAX_PRODUCERS);
 
         for (const auto &prod : sortedprods)
         {
-            if (prod.active() && activecount < MAX_PRODUCERS)   //only count activated producers
-                activecount++;
+            if (prod.active() && snapshot.producers.size() < MAX_PRODUCERS)   //only count activated producers
+                snapshot.producers.push_back(prod.owner);
             else
                 break;
         }
 
+        if (snapshot.producers.empty()) {
+            return;
+        }
+
+        uint32_t activecount = snapshot.producers.size();
+
         // the multiplier is applied to the shares, and the shares are then multiplied by the share value
         // the share value is the total amount of the perblock bucket divided by the sum of the multipliers
         // the sum of the multipliers is the sum of the multipliers for the active producers and the standby producers
@@ -374,32 +462,49 @@ namespace eosiosystem {
             ? ((activecount / 2.0) * (2.0 * 1.2 - (activecount - 1) * 0.02) * 2.0) 
             : (42.0 + ((activecount - 21) / 2.0) * (2.0 * 1.2 - (activecount - 22) * 0.02));
 
-        double shareValue = (double(_gstate.perblock_bucket) / sum_of_multipliers);
-        int32_t index = 0;
+        snapshot.share_value = (double(_gstate.perblock_bucket) / sum_of_multipliers);
 
-        for (const auto &prod : sortedprods) {
+        // the first payments are written right away, the rest by the next onblock calls
+        if (!write_snapshot_payments(snapshot)) {
+            snapshot_singleton(get_self(), get_self().value).set(snapshot, get_self());
+        }
+    }
+
+    void system_contract::continue_claimrewards_snapshot(snapshot_singleton &snapshot_table) {
+        auto snapshot = snapshot_table.get();
+        if (write_snapshot_payments(snapshot)) {
+            snapshot_table.remove();
+        } else {
+            snapshot_table.set(snapshot, get_self());
+        }
+    }
+
+    bool system_contract::write_snapshot_payments(snapshot_state &snapshot) {
+        const uint32_t end = std::min<uint32_t>(snapshot.next_index + snapshot_payments_per_block, snapshot.producers.size());
 
-            if (!prod.active()) //skip inactive producers
-                continue;
+        for (; snapshot.next_index < end; ++snapshot.next_index) {
+            const auto &prod = _producers.get(snapshot.producers[snapshot.next_index].value, "producer not found");
 
             int64_t pay_amount = 0;
-            index++;
+            int32_t index = snapshot.next_index + 1;
 
             if (index <= 21) {
                 // Applying tiered BP pay multiplier for active BPs (rank 1st until 21st) [1.2, 1.18, ... , 0.82, 0.8] multiplied by 2
-                pay_amount = static_cast<int64_t>(shareValue * 2.0 * ((122.0 - 2.0 * index) / 100.0));
-            } else if (index >= 22 && index <= MAX_PRODUCERS) {
+                pay_amount = static_cast<int64_t>(snapshot.share_value * 2.0 * ((122.0 - 2.0 * index) / 100.0));
+            } else {
                 // Applying tiered BP pay multiplier for standby BPs (rank 22nd until 35th) [1.2, 1.18, ... , 0.96, 0.94] multiplied by 1
-                pay_amount = static_cast<int64_t>(shareValue * ((164.0 - 2.0 * index) / 100.0));
-            } else 
-                break;
+                pay_amount = static_cast<int64_t>(snapshot.share_value * ((164.0 - 2.0 * index) / 100.0));
+            }
 
             _gstate.perblock_bucket -= pay_amount;
-            _gstate.total_unpaid_blocks -= prod.unpaid_blocks;
+            _gstate.total_unpaid_blocks -= get_producer_counters(prod).unpaid_blocks;
+            _gstate_tracker.mark_dirty();
 
             _producers.modify(prod, same_payer, [&](auto &p) {
-                p.last_claim_time = ct;
-                p.unpaid_blocks = 0;
+                p.last_claim_time = snapshot.claim_time;
+            });
+            modify_producer_counters(prod, [&](auto &c) {
+                c.unpaid_blocks = 0;
             });
 
             auto itr = _payments.find(prod.owner.value);
@@ -414,6 +519,8 @@ namespace eosiosystem {
                     a.pay += asset(pay_amount, core_symbol());
                 });
         }
+
+        return snapshot.next_index >= snapshot.producers.size();
     }
 
    // TELOS BEGIN
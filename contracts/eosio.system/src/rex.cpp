@@ -93,6 +93,9 @@ namespace eosiosystem {
       auto rex_stake_delta = add_to_rex_balance( owner, payment, rex_received );
       runrex(2);
       update_rex_account( owner, asset( 0, core_symbol() ), rex_stake_delta - payment, true );
+      // TELOS BEGIN
+      add_delegated_stake( owner, -payment.amount );
+      // TELOS END
       // dummy action added so that amount of REX tokens purchased shows up in action trace
       rex_results::buyresult_action buyrex_act( rex_account, std::vector<eosio::permission_level>{ } );
       buyrex_act.send( rex_received );
@@ -979,13 +982,25 @@ namespace eosiosystem {
     */
    void system_contract::process_rex_maturities( const rex_balance_table::const_iterator& bitr )
    {
+      // TELOS BEGIN
+      // buckets are sorted by maturity, the matured ones are a prefix that is removed with a single erase.
+      // Nothing is written when no bucket matured, which only spares a row write where the caller does not
+      // modify the row afterwards: a queued sellrex. The other callers still save one of two updates.
       const time_point_sec now = current_time_point();
+      const auto first_pending = std::find_if( bitr->rex_maturities.begin(), bitr->rex_maturities.end(),
+                                               [&]( const auto& m ) { return m.first > now; } );
+      const auto matured_count = std::distance( bitr->rex_maturities.begin(), first_pending );
+      if ( matured_count == 0 )
+         return;
+
       _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
-         while ( !rb.rex_maturities.empty() && rb.rex_maturities.front().first <= now ) {
-            rb.matured_rex += rb.rex_maturities.front().second;
-            rb.rex_maturities.erase(rb.rex_maturities.begin());
+         const auto matured_end = rb.rex_maturities.begin() + matured_count;
+         for ( auto it = rb.rex_maturities.begin(); it != matured_end; ++it ) {
+            rb.matured_rex += it->second;
          }
+         rb.rex_maturities.erase( rb.rex_maturities.begin(), matured_end );
       });
+      // TELOS END
    }
 
    /**
@@ -1001,10 +1016,12 @@ namespace eosiosystem {
       _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
          int64_t total  = rb.matured_rex - rex_in_sell_order.amount;
          rb.matured_rex = rex_in_sell_order.amount;
-         while ( !rb.rex_maturities.empty() ) {
-            total += rb.rex_maturities.front().second;
-            rb.rex_maturities.erase(rb.rex_maturities.begin());
+         // TELOS BEGIN
+         for ( const auto& m : rb.rex_maturities ) {
+            total += m.second;
          }
+         rb.rex_maturities.clear();
+         // TELOS END
          if ( total > 0 ) {
             rb.rex_maturities.emplace_back( pair_time_point_sec_int64{ get_rex_maturity(), total } );
          }
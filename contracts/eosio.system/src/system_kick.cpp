@@ -1,5 +1,6 @@
 #include <eosio.system/eosio.system.hpp>
 #include <eosio/producer_schedule.hpp>
+#include <eosio.system/schedule_lookup.hpp>
 
 #define MAX_BLOCK_PER_CYCLE 12
 
@@ -22,19 +23,31 @@ namespace eosiosystem {
     return amountBlocksMissed > thresholdMissedBlocks;
   }
 
+  // producers_metric is kept sorted by producer name, see sort_schedule_metrics
+  producer_metric* system_contract::find_producer_metric(name producer) {
+    return find_by_bp_name(_gschedule_metrics.producers_metric, producer);
+  }
+
+  void system_contract::sort_schedule_metrics() {
+    std::sort(_gschedule_metrics.producers_metric.begin(), _gschedule_metrics.producers_metric.end(),
+              [](const producer_metric &a, const producer_metric &b) { return a.bp_name < b.bp_name; });
+    _gschedule_metrics_tracker.mark_dirty();
+  }
+
   void system_contract::reset_schedule_metrics(name producer = name(0)) {
-    for (auto &pm : _gschedule_metrics.producers_metric) {
-      if (producer != name(0) && pm.bp_name == producer) pm.missed_blocks_per_cycle = MAX_BLOCK_PER_CYCLE - 1;
-      else pm.missed_blocks_per_cycle = MAX_BLOCK_PER_CYCLE;
+    for (auto &pm : _gschedule_metrics.producers_metric) pm.missed_blocks_per_cycle = MAX_BLOCK_PER_CYCLE;
+    _gschedule_metrics_tracker.mark_dirty();
+
+    if (producer != name(0)) {
+      if (auto pm = find_producer_metric(producer)) pm->missed_blocks_per_cycle = MAX_BLOCK_PER_CYCLE - 1;
     }
   }
 
   void system_contract::update_producer_missed_blocks(name producer) {
-    for (auto &pm : _gschedule_metrics.producers_metric) {
-      if (pm.bp_name == producer && pm.missed_blocks_per_cycle > 0) {
-        pm.missed_blocks_per_cycle--;
-        break;
-      }
+    auto pm = find_producer_metric(producer);
+    if (pm && pm->missed_blocks_per_cycle > 0) {
+      pm->missed_blocks_per_cycle--;
+      _gschedule_metrics_tracker.mark_dirty();
     }
   }
 
@@ -53,6 +66,19 @@ namespace eosiosystem {
   }
 
   bool system_contract::is_new_schedule_activated(std::vector<name>& active_schedule) {
+    schedule_fingerprint active_fingerprint;
+    for (auto &p : active_schedule) active_fingerprint.add(p);
+
+    if (_gschedule_metrics.proposed_schedule.has_value()) {
+      return active_fingerprint == _gschedule_metrics.proposed_schedule.value();
+    }
+
+    // metrics proposed before the fingerprint was kept, compare the sorted schedules once and keep it from now on
+    schedule_fingerprint proposed_fingerprint;
+    for (auto &p : _gschedule_metrics.producers_metric) proposed_fingerprint.add(p.bp_name);
+    _gschedule_metrics.proposed_schedule = proposed_fingerprint;
+    sort_schedule_metrics();
+
     std::vector<name> new_schedule;
     for (auto &p : _gschedule_metrics.producers_metric) new_schedule.emplace_back(p.bp_name);
 
@@ -67,6 +93,9 @@ namespace eosiosystem {
   }
 
   bool system_contract::check_missed_blocks(block_timestamp timestamp, name producer) {
+    // every path below updates the onblock caller or the block counter correction
+    _gschedule_metrics_tracker.mark_dirty();
+
     if (producer == "eosio"_n) {
       _gschedule_metrics.block_counter_correction++;
       _gschedule_metrics.last_onblock_caller = producer;
@@ -84,11 +113,8 @@ namespace eosiosystem {
       return false;
     } else if (_gschedule_metrics.block_counter_correction > 0) {
       if (_gschedule_metrics.last_onblock_caller == "eosio"_n) {
-        for (auto &pm : _gschedule_metrics.producers_metric) {
-          if (pm.bp_name == producer) {
-            pm.missed_blocks_per_cycle -= uint32_t(_gschedule_metrics.block_counter_correction);
-            break;
-          }
+        if (auto pm = find_producer_metric(producer)) {
+          pm->missed_blocks_per_cycle -= uint32_t(_gschedule_metrics.block_counter_correction);
         }
       } else {
           reset_schedule_metrics();
@@ -116,14 +142,10 @@ namespace eosiosystem {
     }
 
     if (_gschedule_metrics.last_onblock_caller != producer) {
-      for (auto &pm : _gschedule_metrics.producers_metric) {
-        if (pm.bp_name == producer) {                       
-          if (pm.missed_blocks_per_cycle != MAX_BLOCK_PER_CYCLE) {        
-            _gschedule_metrics.last_onblock_caller = producer;
-            return true;
-          }
-          break;
-        }
+      auto pm = find_producer_metric(producer);
+      if (pm && pm->missed_blocks_per_cycle != MAX_BLOCK_PER_CYCLE) {
+        _gschedule_metrics.last_onblock_caller = producer;
+        return true;
       }
     }
     
@@ -1,4 +1,5 @@
 #include <eosio.system/eosio.system.hpp>
+#include <eosio.system/kick_ranking.hpp>
 
 #define TWELVE_HOURS_US 43200000000
 #define SIX_HOURS_US 21600000000
@@ -15,12 +16,14 @@ using namespace eosio;
 void system_contract::set_bps_rotation(name bpOut, name sbpIn) {
   _grotation.bp_currently_out = bpOut;
   _grotation.sbp_currently_in = sbpIn;
+  _grotation_tracker.mark_dirty();
 }
 
 void system_contract::update_rotation_time(block_timestamp block_time) {
   _grotation.last_rotation_time = block_time;
   _grotation.next_rotation_time = block_timestamp(
       block_time.to_time_point() + time_point(microseconds(TWELVE_HOURS_US)));
+  _grotation_tracker.mark_dirty();
 }
 
 void system_contract::update_missed_blocks_per_rotation() {
@@ -29,7 +32,14 @@ void system_contract::update_missed_blocks_per_rotation() {
                     _gschedule_metrics.producers_metric.end());
   uint16_t max_kick_bps = uint16_t(active_schedule_size / 7);
 
-  std::vector<producer_info> prods;
+  // compact ranking records, the iterators are reused to kick
+  struct missed_blocks_rank {
+    producers_table::const_iterator pitr;
+    uint32_t                        missed_blocks_per_rotation;
+    double                          total_votes;
+  };
+  std::vector<missed_blocks_rank> prods;
+  prods.reserve(active_schedule_size);
 
   for (auto &pm : _gschedule_metrics.producers_metric) {
     auto pitr = _producers.find(pm.bp_name.value);
@@ -37,56 +47,56 @@ void system_contract::update_missed_blocks_per_rotation() {
       if (pm.missed_blocks_per_cycle > 0) {
         //  print("\nblock producer: ", name{pm.name}, " missed ",
         //  pm.missed_blocks_per_cycle, " blocks.");
-        _producers.modify(pitr, same_payer, [&](auto &p) {
-          p.missed_blocks_per_rotation += pm.missed_blocks_per_cycle;
-          //   print("\ntotal missed blocks: ", p.missed_blocks_per_rotation);
+        modify_producer_counters(*pitr, [&](auto &c) {
+          c.missed_blocks_per_rotation += pm.missed_blocks_per_cycle;
+          //   print("\ntotal missed blocks: ", c.missed_blocks_per_rotation);
         });
       }
 
-      if (pitr->missed_blocks_per_rotation > 0)
-        prods.emplace_back(*pitr);
+      const auto &counters = get_producer_counters(*pitr);
+      if (counters.missed_blocks_per_rotation > 0)
+        prods.push_back({pitr, counters.missed_blocks_per_rotation, pitr->total_votes});
     }
   }
 
-  std::sort(prods.begin(), prods.end(), [](const producer_info &p1,
-                                           const producer_info &p2) {
-    if (p1.missed_blocks_per_rotation != p2.missed_blocks_per_rotation)
-      return p1.missed_blocks_per_rotation > p2.missed_blocks_per_rotation;
-    else
-      return p1.total_votes < p2.total_votes;
-  });
-
-  for (auto &prod : prods) {
-    auto pitr = _producers.find(prod.owner.value);
-
-    if (crossed_missed_blocks_threshold(pitr->missed_blocks_per_rotation,
-                                        uint32_t(active_schedule_size)) &&
-        max_kick_bps > 0) {
-      _producers.modify(pitr, same_payer, [&](auto &p) {
-        p.lifetime_missed_blocks += p.missed_blocks_per_rotation;
+  // at most `max_kick_bps` producers are kicked, only that many need to be ranked
+  auto ranked_end = rank_kick_candidates(prods, max_kick_bps);
+
+  for (auto it = prods.begin(); it != ranked_end; ++it) {
+    if (crossed_missed_blocks_threshold(it->missed_blocks_per_rotation,
+                                        uint32_t(active_schedule_size))) {
+      _producers.modify(it->pitr, same_payer, [&](auto &p) {
         p.kick(kick_type::REACHED_TRESHOLD);
       });
-      max_kick_bps--;
+      modify_producer_counters(*it->pitr, [&](auto &c) {
+        c.lifetime_missed_blocks += c.missed_blocks_per_rotation;
+        c.kick();
+      });
     } else
       break;
   }
 }
 
 void system_contract::restart_missed_blocks_per_rotation(
-    std::vector<producer_location_pair> prods) {
+    const std::vector<producer_location_pair> &prods) {
   // restart all missed blocks to bps and sbps
   for (size_t i = 0; i < prods.size(); i++) {
     auto bp_name = prods[i].first.producer_name;
     auto pitr = _producers.find(bp_name.value);
 
     if (pitr != _producers.end()) {
-      _producers.modify(pitr, same_payer, [&](auto &p) {
-        if (p.times_kicked > 0 && p.missed_blocks_per_rotation == 0) {
+      const auto &counters = get_producer_counters(*pitr);
+      if (pitr->times_kicked > 0 && counters.missed_blocks_per_rotation == 0) {
+        _producers.modify(pitr, same_payer, [&](auto &p) {
           p.times_kicked--;
-        }
-        p.lifetime_missed_blocks += p.missed_blocks_per_rotation;
-        p.missed_blocks_per_rotation = 0;
-      });
+        });
+      }
+      if (counters.missed_blocks_per_rotation > 0) {
+        modify_producer_counters(*pitr, [&](auto &c) {
+          c.lifetime_missed_blocks += c.missed_blocks_per_rotation;
+          c.missed_blocks_per_rotation = 0;
+        });
+      }
     }
   }
 }
@@ -95,7 +105,9 @@ void system_contract::restart_missed_blocks_per_rotation(
      return index >= low_bound && index < up_bound;
    } 
 
-std::vector<producer_location_pair> system_contract::check_rotation_state( std::vector<producer_location_pair> prods, block_timestamp block_time) {
+// Rotates the ranked producers in place: the standby producer rotated in takes the position of the producer
+// rotated out, which moves out of the schedule, and the list is truncated to the schedule.
+void system_contract::check_rotation_state( std::vector<producer_location_pair> &prods, block_timestamp block_time) {
       uint32_t total_active_voted_prods = prods.size(); 
       std::vector<producer_location_pair>::iterator it_bp = prods.end();
       std::vector<producer_location_pair>::iterator it_sbp = prods.end();
@@ -105,6 +117,7 @@ std::vector<producer_location_pair> system_contract::check_rotation_state( std::
         if (total_active_voted_prods > TOP_PRODUCERS) {
           _grotation.bp_out_index = _grotation.bp_out_index >= TOP_PRODUCERS - 1 ? 0 : _grotation.bp_out_index + 1;
           _grotation.sbp_in_index = _grotation.sbp_in_index >= total_active_voted_prods - 1 ? TOP_PRODUCERS : _grotation.sbp_in_index + 1;
+          _grotation_tracker.mark_dirty();
 
           name bp_name = prods[_grotation.bp_out_index].first.producer_name;
           name sbp_name = prods[_grotation.sbp_in_index].first.producer_name;
@@ -138,6 +151,7 @@ std::vector<producer_location_pair> system_contract::check_rotation_state( std::
             if(total_active_voted_prods < TOP_PRODUCERS) {
               _grotation.bp_out_index = TOP_PRODUCERS;
               _grotation.sbp_in_index = MAX_PRODUCERS+1;
+              _grotation_tracker.mark_dirty();
             }
           } else if (total_active_voted_prods > TOP_PRODUCERS && 
                     (!is_in_range(_bp_index, 0, TOP_PRODUCERS) || !is_in_range(_sbp_index, TOP_PRODUCERS, MAX_PRODUCERS))) {
@@ -148,30 +162,12 @@ std::vector<producer_location_pair> system_contract::check_rotation_state( std::
         }
     }
 
-      std::vector<producer_location_pair>  top_producers;
-
-      //Rotation
-      if(it_bp != prods.end() && it_sbp != prods.end()) {
-        for ( auto pIt = prods.begin(); pIt != prods.end(); ++pIt) {
-          auto i = std::distance(prods.begin(), pIt); 
-          // print("\ni-> ", i);
-          if(i > TOP_PRODUCERS - 1) break;
-
-          if(pIt->first.producer_name == it_bp->first.producer_name) {
-            // print("\nprod sbp added to schedule -> ", name{it_sbp->producer_name});
-            top_producers.emplace_back(*it_sbp);
-          } else {
-            // print("\nprod bp added to schedule -> ", name{pIt->producer_name});
-            top_producers.emplace_back(*pIt);
-          } 
-        }
-      } 
-      else {
-        top_producers = prods;
-        if(prods.size() > TOP_PRODUCERS) top_producers.resize(TOP_PRODUCERS);
-        else top_producers.resize(prods.size());
+      //Rotation, only a producer of the schedule is replaced by a standby producer
+      if(it_bp != prods.end() && it_sbp != prods.end() &&
+         std::distance(prods.begin(), it_bp) < TOP_PRODUCERS && std::distance(prods.begin(), it_sbp) >= TOP_PRODUCERS) {
+        std::iter_swap(it_bp, it_sbp);
       }
 
-  return top_producers;
+      if(prods.size() > TOP_PRODUCERS) prods.resize(TOP_PRODUCERS);
 }
 }
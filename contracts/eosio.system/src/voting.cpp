@@ -8,6 +8,8 @@
 #include <eosio/singleton.hpp>
 
 #include <eosio.system/eosio.system.hpp>
+#include <eosio.system/inverse_vote_weights.hpp>
+#include <eosio.system/vote_math.hpp>
 #include <eosio.token/eosio.token.hpp>
 
 #include <intx/intx.hpp>
@@ -125,17 +127,17 @@ namespace eosiosystem {
 
    void system_contract::update_elected_producers( const block_timestamp& block_time ) {
       _gstate.last_producer_schedule_update = block_time;
+      _gstate_tracker.mark_dirty();
 
       auto idx = _producers.get_index<"prototalvote"_n>();
 
       // TELOS BEGIN
-      uint32_t totalActiveVotedProds = uint32_t(std::distance(idx.begin(), idx.end()));
-      totalActiveVotedProds = totalActiveVotedProds > MAX_PRODUCERS ? MAX_PRODUCERS : totalActiveVotedProds;
+      // `by_votes` negates the votes of active producers only, so the voted active producers are the prefix of the
+      // index by decreasing votes and the walk stops at the first unvoted or inactive one, or after MAX_PRODUCERS
+      std::vector< producer_location_pair > active_producers;
+      active_producers.reserve(MAX_PRODUCERS);
 
-      std::vector< producer_location_pair > active_producers, top_producers;
-      active_producers.reserve(totalActiveVotedProds);
-
-      for( auto it = idx.cbegin(); it != idx.cend() && active_producers.size() < totalActiveVotedProds /*TELOS*/ && 0 < it->total_votes && it->active(); ++it ) {
+      for( auto it = idx.cbegin(); it != idx.cend() && active_producers.size() < MAX_PRODUCERS /*TELOS*/ && 0 < it->total_votes && it->active(); ++it ) {
          active_producers.emplace_back(
             eosio::producer_authority{
                .producer_name = it->owner,
@@ -149,7 +151,9 @@ namespace eosiosystem {
          return;
       }
 
-      top_producers = check_rotation_state(active_producers, block_time);
+      // the ranked producers are rotated and truncated in place, they now hold the schedule
+      check_rotation_state(active_producers, block_time);
+      auto& top_producers = active_producers;
       // TELOS END
 
       std::sort( top_producers.begin(), top_producers.end(), []( const producer_location_pair& lhs, const producer_location_pair& rhs ) {
@@ -164,6 +168,13 @@ namespace eosiosystem {
          producers.push_back( std::move(item.first) );
 
       // TELOS BEGIN
+      // the schedule last proposed is already pending or active, proposing it again would change nothing
+      const auto packed_producers = eosio::pack(producers);
+      const auto schedule_digest = eosio::sha256(packed_producers.data(), packed_producers.size());
+      if (_gschedule_metrics.proposed_schedule_digest.has_value() && _gschedule_metrics.proposed_schedule_digest.value() == schedule_digest) {
+        return;
+      }
+
       auto schedule_version = set_proposed_producers(producers);
       if (schedule_version >= 0) {
         print("\n**new schedule was proposed**");
@@ -173,12 +184,18 @@ namespace eosiosystem {
         _gschedule_metrics.producers_metric.erase( _gschedule_metrics.producers_metric.begin(), _gschedule_metrics.producers_metric.end());
 
         std::vector<producer_metric> psm;
-        std::for_each(top_producers.begin(), top_producers.end(), [&psm](auto &tp) {
+        schedule_fingerprint fingerprint;
+        std::for_each(top_producers.begin(), top_producers.end(), [&psm, &fingerprint](auto &tp) {
           auto bp_name = tp.first.producer_name;
           psm.emplace_back(producer_metric{ bp_name, 12 });
+          fingerprint.add(bp_name);
         });
 
         _gschedule_metrics.producers_metric = psm;
+        _gschedule_metrics.proposed_schedule = fingerprint;
+        _gschedule_metrics.proposed_schedule_digest = schedule_digest;
+        sort_schedule_metrics();
+        _gschedule_metrics_tracker.mark_dirty();
 
         _gstate.last_producer_schedule_size = static_cast<decltype(_gstate.last_producer_schedule_size)>(top_producers.size());
       }
@@ -195,68 +212,83 @@ namespace eosiosystem {
    /*
    * This function caculates the inverse weight voting.
    * The maximum weighted vote will be reached if an account votes for the maximum number of registered producers (up to 30 in total).
+   * The weight of each number of voted producers is looked up in `inverse_vote_weights`.
    */
    double system_contract::inverse_vote_weight(double staked, double amount_voted_producers) {
-     if (amount_voted_producers == 0.0) {
-       return 0;
-     }
-
-     double percentVoted = amount_voted_producers / MAX_VOTE_PRODUCERS;
-     double voteWeight = (sin(M_PI * percentVoted - M_PI_2) + 1.0) / 2.0;
-     return (voteWeight * staked);
+     check(amount_voted_producers <= MAX_VOTE_PRODUCERS, "attempt to vote for too many producers");
+     return inverse_vote_weights[size_t(amount_voted_producers)] * staked;
    }
 
    double system_contract::decay_vote_weight_multiplier(double weighted_vote) {
       auto sec_since_epoch = current_time_point().sec_since_epoch();
-      return apply_decay_multiplier(
-         weighted_vote,
-         sec_since_epoch,
-         _gvoting_config.decay_start_epoch,
-         _gvoting_config.decay_increase_yearly
-      );
+      // the multiplier only depends on the time and the voting config, an action updating many voters computes it once
+      if (!_decay_multiplier_memo
+          || _decay_multiplier_memo->sec_since_epoch != sec_since_epoch
+          || _decay_multiplier_memo->decay_start_epoch != _gvoting_config.decay_start_epoch
+          || _decay_multiplier_memo->decay_increase_yearly != _gvoting_config.decay_increase_yearly) {
+         _decay_multiplier_memo = decay_multiplier_memo{
+            sec_since_epoch,
+            _gvoting_config.decay_start_epoch,
+            _gvoting_config.decay_increase_yearly,
+            vote_math::decay_multiplier(sec_since_epoch, _gvoting_config.decay_start_epoch, _gvoting_config.decay_increase_yearly)
+         };
+      }
+      return weighted_vote * _decay_multiplier_memo->multiplier;
    }
 
-   // helper: 256-bit → double without __floatuntitf
-   double system_contract::uint256_to_double(uint256 x)
-   {
-      const uint64_t* w = intx::as_words(x);        // little-endian 4×u64
-      constexpr double TWO64 = 18446744073709551616.0;   // 2⁶⁴ (exact)
-      double d = 0.0;
-      for (int i = 3; i >= 0; --i)                  // most-sig → least-sig
-         d = d * TWO64 + static_cast<double>(w[i]);
-      return d;
+   double system_contract::whole_vote_weight(double weight) {
+      return weight > 0 ? std::floor(weight) : 0;
    }
 
-   double system_contract::apply_decay_multiplier(
-      double        weighted_vote,
-      uint32_t      sec_since_epoch,
-      uint64_t      decay_start_epoch,
-      uint64_t      decay_increase_yearly_pct   // e.g. 5e17 for 50 %
-   ) {
-      constexpr uint64_t SECONDS_PER_YEAR     = 31'536'000ULL;              // 365 d
-      const     uint256 DECAY_PRECISION       = uint256{1'000'000'000'000'000'000ULL}; // 1e18
-      constexpr uint64_t PERCENT_DENOMINATOR  = 100ULL;                     // 100 %
-
-      if (decay_start_epoch == 0 || sec_since_epoch <= decay_start_epoch)
-         return weighted_vote;
-
-      uint64_t seconds_of_decay = sec_since_epoch - decay_start_epoch;
-
-      /* 1 ▸ percent → 1 × 10¹⁸ fixed-point (≤ 1e20, well inside 256 bits) */
-      uint256 yearly_rate_scaled =
-         uint256{decay_increase_yearly_pct} * DECAY_PRECISION / PERCENT_DENOMINATOR;
-
-      /* 2 ▸ increment = rate × t / year (still fixed-point) */
-      uint256 increment_fp =
-         (yearly_rate_scaled * uint256{seconds_of_decay}) / SECONDS_PER_YEAR;
-
-      uint256 decay_multiplier_fp = DECAY_PRECISION + increment_fp;
+   // The same stored boost and weight always give the same boost weight, so it is removed exactly as it was added
+   double system_contract::self_stake_boost_weight(uint64_t self_stake_boost, double weight) {
+      return whole_vote_weight((self_stake_boost/100.0)*weight);
+   }
 
-      /* 3 ▸ one final cast to IEEE-754 */
-      double multiplier = uint256_to_double(decay_multiplier_fp) /
-                          uint256_to_double(DECAY_PRECISION);
+   void system_contract::add_producer_votes(producer_info& prod, double delta) {
+      prod.total_votes += delta;
+      if ( prod.total_votes < 0 ) { // only totals accounted before whole vote units can drift below zero
+         prod.total_votes = 0;
+      }
+      _gstate.total_producer_vote_weight += delta;
+      _gstate_tracker.mark_dirty();
+      check( _gstate.total_producer_vote_weight < max_exact_vote_weight, "total producer vote weight exceeds the exact range" );
+   }
 
-      return weighted_vote * multiplier;
+   void system_contract::apply_producer_vote_deltas( const producer_vote_deltas& deltas, bool voting, bool recalculated ) {
+      for( const auto& pd : deltas ) {
+         auto pitr = _producers.find( pd.producer.value );
+         if( pitr != _producers.end() ) {
+            if( voting && !pitr->active() && pd.from_new_set ) {
+               check( false, ( "producer " + pitr->owner.to_string() + " is not currently registered" ).data() );
+            }
+            if( pd.delta == 0 ) { // unchanged votes leave the producer row untouched
+               continue;
+            }
+            if( recalculated ) {
+               update_recalc_votes( pd.producer, pd.delta );
+            }
+            if( _producer_votes_batch ) { // written once per producer when the batch completes
+               auto& batch = *_producer_votes_batch;
+               auto bitr = std::lower_bound( batch.begin(), batch.end(), pd.producer, []( const producer_vote_delta& d, const name& p ) {
+                  return d.producer < p;
+               });
+               if( bitr != batch.end() && bitr->producer == pd.producer ) {
+                  bitr->delta += pd.delta;
+               } else {
+                  batch.insert( bitr, pd );
+               }
+               continue;
+            }
+            _producers.modify( pitr, same_payer, [&]( auto& p ) {
+               add_producer_votes( p, pd.delta );
+            });
+         } else {
+            if( pd.from_new_set ) {
+               check( false, ( "producer " + pd.producer.to_string() + " is not registered" ).data() );
+            }
+         }
+      }
    }
 
    // TELOS END
@@ -285,6 +317,8 @@ namespace eosiosystem {
       }
 
       _gstate3.last_vpay_state_update = ct;
+      _gstate2_tracker.mark_dirty();
+      _gstate3_tracker.mark_dirty();
 
       return _gstate2.total_producer_votepay_share;
    }
@@ -338,32 +372,74 @@ namespace eosiosystem {
       auto voter = _voters.find( voter_name.value );
       check( voter != _voters.end(), "no voter found" );
 
-      int64_t new_staked = 0;
-
       updaterex(voter_name);
 
+      update_voter_staked(*voter);
+
+      update_votes(voter_name, voter->proxy, voter->producers, true);
+   } // voteupdate
+
+   // TELOS BEGIN
+   void system_contract::update_voter_staked( const voter_info& voter ) {
+      int64_t new_staked = 0;
+
       // get rex bal
-      auto rex_itr = _rexbalance.find( voter_name.value );
+      auto rex_itr = _rexbalance.find( voter.owner.value );
       if( rex_itr != _rexbalance.end() && rex_itr->rex_balance.amount > 0 ) {
          new_staked += rex_itr->vote_stake.amount;
       }
-      del_bandwidth_table     del_tbl( get_self(), voter_name.value );
 
-      auto del_itr = del_tbl.begin();
-      while(del_itr != del_tbl.end()) {
-         new_staked += del_itr->net_weight.amount + del_itr->cpu_weight.amount;
-         del_itr++;
-      }
+      // the delband scope is only walked once per voter, to initialize the delegated stake total
+      const symbol  core      = core_symbol();
+      const bool    kept      = voter.has_delegated_stake( core );
+      const int64_t delegated = kept ? voter.reserved3.amount : sum_delegated_stake( voter.owner );
+      new_staked += delegated;
 
-      if( voter->staked != new_staked){
+      if( voter.staked != new_staked || !kept ){
          // check if staked and new_staked are different and only
          _voters.modify( voter, same_payer, [&]( auto& av ) {
-            av.staked = new_staked;
+            av.staked    = new_staked;
+            av.reserved3 = asset( delegated, core );
          });
       }
+   }
 
-      update_votes(voter_name, voter->proxy, voter->producers, true);
-   } // voteupdate
+   int64_t system_contract::sum_delegated_stake( const name& owner ) {
+      int64_t total = 0;
+      del_bandwidth_table del_tbl( get_self(), owner.value );
+      for( const auto& del : del_tbl ) {
+         total += del.net_weight.amount + del.cpu_weight.amount;
+      }
+      return total;
+   }
+
+   void system_contract::add_delegated_stake( const name& owner, int64_t delta ) {
+      auto voter = _voters.find( owner.value );
+      if( voter == _voters.end() ) {
+         return;
+      }
+      const symbol core = core_symbol();
+      // delband already includes `delta` here, so a total that is not kept yet is taken from it as a whole
+      const int64_t total = voter->has_delegated_stake( core ) ? voter->reserved3.amount + delta
+                                                               : sum_delegated_stake( owner );
+      check( 0 <= total, "delegated stake cannot be negative" );
+      _voters.modify( voter, same_payer, [&]( auto& v ) {
+         v.reserved3 = asset( total, core );
+      });
+   }
+
+   void system_contract::auditdeleg( const name& account ) {
+      const auto& voter = _voters.get( account.value, "no voter found" );
+      const int64_t total = sum_delegated_stake( account );
+      if( voter.has_delegated_stake( core_symbol() ) ) {
+         check( voter.reserved3.amount == total, "delegated stake total does not match delband" );
+         return;
+      }
+      _voters.modify( voter, same_payer, [&]( auto& v ) {
+         v.reserved3 = asset( total, core_symbol() );
+      });
+   }
+   // TELOS END
 
 
    void system_contract::update_votes( const name& voter_name, const name& proxy, const std::vector<name>& producers, bool voting ) {
@@ -397,14 +473,21 @@ namespace eosiosystem {
       // when a voter or a proxy votes or changes stake, the total_activated stake should be re-calculated
       // any proxy stake handling should be done when the proxy votes or on weight propagation
       // if(_gstate.thresh_activated_stake_time == 0 && !proxy && !voter->proxy){
+      // a voter already covered by a vote recalculation in progress also updates the recalculated totals
+      const bool recalculated = is_vote_recalculated( voter_name );
+      const int64_t activated_stake_before = _gstate.total_activated_stake;
+
       if(!proxy && !voter->proxy){
          _gstate.total_activated_stake += totalStaked - voter->last_stake;
       }
 
       auto inverse_weighted_vote = inverse_vote_weight((double)totalStaked, (double) producers.size());
-      auto new_vote_weight = decay_vote_weight_multiplier(inverse_weighted_vote);
+      auto new_vote_weight = whole_vote_weight(decay_vote_weight_multiplier(inverse_weighted_vote));
 
-      std::map<name, std::pair< double, bool > > producer_deltas;
+      // the previous votes are removed unless they went to a proxy, the new ones added unless they go to a proxy
+      const std::vector<name> no_producers;
+      producer_vote_deltas producer_deltas( voter->last_stake > 0 && !voter->proxy ? voter->producers : no_producers, voter->last_vote_weight,
+                                            !proxy && new_vote_weight >= 0 ? producers : no_producers, new_vote_weight );
 
       // print("\n Voter : ", voter->last_stake, " = ", voter->last_vote_weight, " = ", proxy, " = ", producers.size(), " = ", totalStaked, " = ", new_vote_weight);
 
@@ -433,14 +516,9 @@ namespace eosiosystem {
                propagate_weight_change( *old_proxy );
             }
          } else {
-            for( const auto& p : voter->producers ) {
-               auto& d = producer_deltas[p];
-               d.first -= voter->last_vote_weight;
-               d.second = false;
-               if (p == voter_name) {
-                  d.first -= (self_stake_boost/100.0)*voter->last_vote_weight;
-                  self_stake_boost = 0;
-               }
+            if( std::binary_search( voter->producers.begin(), voter->producers.end(), voter_name ) ) {
+               producer_deltas.add( voter_name, -self_stake_boost_weight(self_stake_boost, voter->last_vote_weight) );
+               self_stake_boost = 0;
             }
          }
       }
@@ -460,38 +538,14 @@ namespace eosiosystem {
          }
       } else {
          if( new_vote_weight >= 0 ) {
-            for( const auto& p : producers ) {
-               auto& d = producer_deltas[p];
-               d.first += new_vote_weight;
-               d.second = true;
-               if (p == voter_name) {
-                  self_stake_boost = _gvoting_config.self_stake_boost_multiplier;
-                  d.first += (self_stake_boost/100.0)*new_vote_weight;
-               }
+            if( std::binary_search( producers.begin(), producers.end(), voter_name ) ) {
+               self_stake_boost = _gvoting_config.self_stake_boost_multiplier;
+               producer_deltas.add( voter_name, self_stake_boost_weight(self_stake_boost, new_vote_weight) );
             }
          }
       }
 
-      for( const auto& pd : producer_deltas ) {
-         auto pitr = _producers.find( pd.first.value );
-         if( pitr != _producers.end() ) {
-            if( voting && !pitr->active() && pd.second.second /* from new set */ ) {
-               check( false, ( "producer " + pitr->owner.to_string() + " is not currently registered" ).data() );
-            }
-            _producers.modify( pitr, same_payer, [&]( auto& p ) {
-               p.total_votes += pd.second.first;
-               if ( p.total_votes < 0 ) { // floating point arithmetics can give small negative numbers
-                  p.total_votes = 0;
-               }
-               _gstate.total_producer_vote_weight += pd.second.first;
-               //check( p.total_votes >= 0, "something bad happened" );
-            });
-         } else {
-            if( pd.second.second ) {
-               check( false, ( "producer " + pd.first.to_string() + " is not registered" ).data() );
-            }
-         }
-      }
+      apply_producer_vote_deltas( producer_deltas, voting, recalculated );
 
       _voters.modify( voter, same_payer, [&]( auto& av ) {
          av.last_vote_weight = new_vote_weight;
@@ -500,6 +554,14 @@ namespace eosiosystem {
          av.proxy     = proxy;
          av.self_stake_boost = self_stake_boost;
       });
+
+      if( _gstate.total_activated_stake != activated_stake_before ) {
+         _gstate_tracker.mark_dirty();
+      }
+      if( recalculated && _gstate.total_activated_stake != activated_stake_before ) {
+         _grecalc->total_activated_stake += _gstate.total_activated_stake - activated_stake_before;
+         _recalc.set( *_grecalc, get_self() );
+      }
       // TELOS END
    }
 
@@ -558,6 +620,7 @@ namespace eosiosystem {
                   p.total_votes += delta;
                   _gstate.total_producer_vote_weight += delta;
                });
+               _gstate_tracker.mark_dirty();
                auto prod2 = _producers2.find( acnt.value );
                if ( prod2 != _producers2.end() ) {
                   const auto last_claim_plus_3days = prod.last_claim_time + microseconds(3 * useconds_per_day);
@@ -592,8 +655,7 @@ namespace eosiosystem {
       if(voter.is_proxy){
          totalStake += voter.proxied_vote_weight;
       }
-      double new_weight = inverse_vote_weight((double)totalStake, voter.producers.size());
-      double delta = new_weight - voter.last_vote_weight;
+      double new_weight = whole_vote_weight(inverse_vote_weight((double)totalStake, voter.producers.size()));
 
       if (voter.proxy) { // this part should never happen since the function is called only on proxies
          if(voter.last_stake != totalStake){
@@ -605,13 +667,8 @@ namespace eosiosystem {
             propagate_weight_change(proxy);
          }
       } else {
-         for (auto acnt : voter.producers) {
-            auto &pitr = _producers.get(acnt.value, "producer not found"); // data corruption
-            _producers.modify(pitr, same_payer, [&](auto &p) {
-               p.total_votes += delta;
-               _gstate.total_producer_vote_weight += delta;
-            });
-         }
+         apply_producer_vote_deltas(producer_vote_deltas(voter.producers, voter.last_vote_weight, voter.producers, new_weight),
+                                    false, is_vote_recalculated(voter.owner));
       }
 
       _voters.modify(voter, same_payer, [&](auto &v) {
@@ -622,37 +679,200 @@ namespace eosiosystem {
    }
 
    // TELOS BEGIN
-   void system_contract::recalculate_votes(){
-    if (_gstate.total_producer_vote_weight <= -0.1){ // -0.1 threshold for floating point calc ?
-        _gstate.total_producer_vote_weight = 0;
-        _gstate.total_activated_stake = 0;
-        for(auto producer = _producers.begin(); producer != _producers.end(); ++producer){
-            _producers.modify(producer, same_payer, [&](auto &p) {
-                p.total_votes = 0;
+   // Vote recalculation is paginated: voters are recalculated in primary key order, `recalc_voters_per_block`
+   // per `onblock` or `max` per `recalcvotes`, and their weights are accumulated in `recalcvotes` while the
+   // producers keep their current totals. Votes cast meanwhile by voters before the cursor are mirrored into
+   // the accumulated totals by `update_votes`, the ones after the cursor are picked up when it reaches them.
+   // Once the last voter is done the accumulated totals replace the producer totals in a single step.
+   void system_contract::recalculate_votes() {
+      if( !_grecalc ) {
+         if( _gstate.total_producer_vote_weight > -0.1 ) { // -0.1 threshold for floating point calc
+            return;
+         }
+         start_vote_recalculation();
+      }
+      process_vote_recalculation( recalc_voters_per_block );
+   }
+
+   void system_contract::recalcvotes( const name& user, uint16_t max ) {
+      require_auth( user );
+      check( max > 0, "max must be positive" );
+
+      if( !_grecalc ) {
+         require_auth( get_self() );
+         start_vote_recalculation();
+      }
+      process_vote_recalculation( max );
+   }
+
+   void system_contract::start_vote_recalculation() {
+      _grecalc.emplace();
+      _grecalc->started = eosio::current_block_time();
+      _recalc.set( *_grecalc, get_self() );
+   }
+
+   void system_contract::process_vote_recalculation( uint32_t max ) {
+      auto& state = *_grecalc;
+
+      auto voter = _voters.lower_bound( state.next_voter.value );
+      for( uint32_t processed = 0; voter != _voters.end() && processed < max; ++voter, ++processed ) {
+         state.total_activated_stake += recalculate_voter( *voter );
+         ++state.voters_processed;
+      }
+
+      if( voter != _voters.end() ) {
+         state.next_voter = voter->owner;
+         _recalc.set( state, get_self() );
+         return;
+      }
+
+      // every voter has been recalculated, swap in the new totals together with the EVM votes
+      recalc_votes_table recalc_votes( get_self(), get_self().value );
+      double total_producer_vote_weight = 0;
+      for( auto pitr = _producers.begin(); pitr != _producers.end(); ++pitr ) {
+         double total_votes = 0;
+         auto ritr = recalc_votes.find( pitr->owner.value );
+         if( ritr != recalc_votes.end() ) {
+            total_votes = ritr->total_votes;
+            recalc_votes.erase( ritr );
+         }
+         auto eitr = _evm_votes.find( pitr->owner.value );
+         if( eitr != _evm_votes.end() ) {
+            total_votes += double( evm_vote_weight( eitr->total_vote ) );
+         }
+         if( total_votes < 0 ) { // only possible while migrating totals accounted before whole vote units
+            total_votes = 0;
+         }
+         if( pitr->total_votes != total_votes ) {
+            _producers.modify( pitr, same_payer, [&]( auto& p ) {
+               p.total_votes = total_votes;
             });
-        }
-        std::map< name, bool> processed_proxies;
-        for (auto voter = _voters.begin(); voter != _voters.end(); ++voter) {
-            if(voter->proxy && !processed_proxies[voter->proxy]){
-                auto proxy = _voters.find(voter->proxy.value);
-                _voters.modify( proxy, same_payer, [&]( auto& av ) {
-                    av.last_vote_weight = 0;
-                    av.last_stake = 0;
-                    av.proxied_vote_weight = 0;
-                });
-                processed_proxies[voter->proxy] = true;
-            }
-            if(!voter->is_proxy || !processed_proxies[voter->owner]){
-                _voters.modify( voter, same_payer, [&]( auto& av ) {
-                    av.last_vote_weight = 0;
-                    av.last_stake = 0;
-                    av.proxied_vote_weight = 0;
-                });
-                processed_proxies[voter->owner] = true;
-            }
-            update_votes(voter->owner, voter->proxy, voter->producers, true);
-        }
-    }
+         }
+         total_producer_vote_weight += total_votes;
+      }
+      for( auto ritr = recalc_votes.begin(); ritr != recalc_votes.end(); ) {
+         ritr = recalc_votes.erase( ritr );
+      }
+
+      _gstate.total_producer_vote_weight = total_producer_vote_weight;
+      _gstate.total_activated_stake = state.total_activated_stake;
+      _gstate_tracker.mark_dirty();
+      _recalc.remove();
+      _grecalc.reset();
+   }
+
+   int64_t system_contract::recalculate_voter( const voter_info& voter ) {
+      // proxied stake is carried by the proxy through its proxied_vote_weight
+      if( voter.proxy ) {
+         auto proxy = _voters.find( voter.proxy.value );
+         return proxy != _voters.end() && proxy->last_vote_weight > 0 ? voter.staked : 0;
+      }
+
+      int64_t totalStaked = voter.staked;
+      if( voter.is_proxy ) {
+         totalStaked += voter.proxied_vote_weight;
+      }
+      if( voter.producers.empty() ) {
+         totalStaked = 0;
+      }
+
+      double new_vote_weight = whole_vote_weight( decay_vote_weight_multiplier( inverse_vote_weight( (double)totalStaked, (double)voter.producers.size() ) ) );
+      uint64_t self_stake_boost = 0;
+      for( const auto& p : voter.producers ) {
+         if( _producers.find( p.value ) == _producers.end() ) {
+            continue;
+         }
+         double delta = new_vote_weight;
+         if( p == voter.owner ) {
+            self_stake_boost = _gvoting_config.self_stake_boost_multiplier;
+            delta += self_stake_boost_weight( self_stake_boost, new_vote_weight );
+         }
+         update_recalc_votes( p, delta );
+      }
+
+      _voters.modify( voter, same_payer, [&]( auto& av ) {
+         av.last_vote_weight = new_vote_weight;
+         av.last_stake = totalStaked;
+         av.self_stake_boost = self_stake_boost;
+      });
+      return totalStaked;
+   }
+
+   bool system_contract::is_vote_recalculated( const name& voter ) {
+      return _grecalc && voter.value < _grecalc->next_voter.value;
+   }
+
+   void system_contract::update_recalc_votes( const name& producer, double delta ) {
+      recalc_votes_table recalc_votes( get_self(), get_self().value );
+      auto ritr = recalc_votes.find( producer.value );
+      if( ritr == recalc_votes.end() ) {
+         recalc_votes.emplace( get_self(), [&]( auto& r ) {
+            r.owner = producer;
+            r.total_votes = delta;
+         });
+      } else {
+         recalc_votes.modify( ritr, same_payer, [&]( auto& r ) {
+            r.total_votes += delta;
+         });
+      }
+   }
+
+   void system_contract::voteupdbatch( const std::vector<name>& voters ) {
+      check( !voters.empty(), "no voters to update" );
+
+      _producer_votes_batch.emplace();
+      for( const auto& voter_name : voters ) {
+         auto voter = _voters.find( voter_name.value );
+         check( voter != _voters.end(), "no voter found" );
+         update_voter_batched( *voter );
+      }
+      write_producer_votes_batch();
+   }
+
+   void system_contract::voteupdall( uint16_t max ) {
+      check( max > 0, "max must be positive" );
+
+      vote_update_singleton vote_update( get_self(), get_self().value );
+      auto state = vote_update.get_or_default();
+
+      _producer_votes_batch.emplace();
+      auto voter = _voters.lower_bound( state.next_voter.value );
+      for( uint32_t processed = 0; voter != _voters.end() && processed < max; ++voter, ++processed ) {
+         update_voter_batched( *voter );
+         ++state.voters_updated;
+      }
+      write_producer_votes_batch();
+
+      if( voter == _voters.end() ) {
+         vote_update.remove();
+      } else {
+         state.next_voter = voter->owner;
+         vote_update.set( state, get_self() );
+      }
+   }
+
+   // Unlike `voteupdate`, a batched update is not a new vote: it neither refreshes the REX balance, which needs the
+   // authority of the voter, nor fails on a voted producer that has been unregistered since. Voters without votes
+   // are skipped, they have no weight to update.
+   void system_contract::update_voter_batched( const voter_info& voter ) {
+      if( voter.producers.empty() && !voter.proxy ) {
+         return;
+      }
+      update_voter_staked( voter );
+      update_votes( voter.owner, voter.proxy, voter.producers, false );
+   }
+
+   void system_contract::write_producer_votes_batch() {
+      for( const auto& pd : *_producer_votes_batch ) {
+         if( pd.delta == 0 ) {
+            continue;
+         }
+         const auto& prod = _producers.get( pd.producer.value, "producer not found" );
+         _producers.modify( prod, same_payer, [&]( auto& p ) {
+            add_producer_votes( p, pd.delta );
+         });
+      }
+      _producer_votes_batch.reset();
    }
    // TELOS END
 
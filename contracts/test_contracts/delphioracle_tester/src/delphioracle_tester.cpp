@@ -0,0 +1,52 @@
+#include <eosio/contract.hpp>
+#include <eosio/multi_index.hpp>
+#include <eosio/name.hpp>
+#include <eosio/time.hpp>
+
+/// Stands in for the delphi oracle in the system contract tests: it keeps the averages table the TLOS
+/// price is read from, and lets the tests write and erase its rows directly.
+class [[eosio::contract]]
+delphioracle_tester : public eosio::contract {
+public:
+   using contract::contract;
+
+   /// Same layout and indices as `delphioracle::averages`
+   struct [[eosio::table]] averages {
+      uint64_t          id;
+      uint8_t           type;
+      uint64_t          value;
+      eosio::time_point timestamp;
+
+      uint64_t primary_key() const { return id; }
+      uint64_t by_timestamp() const { return timestamp.elapsed.to_seconds(); }
+      uint64_t by_type() const { return type; }
+   };
+
+   typedef eosio::multi_index<"averages"_n, averages,
+      eosio::indexed_by<"timestamp"_n, eosio::const_mem_fun<averages, uint64_t, &averages::by_timestamp>>,
+      eosio::indexed_by<"type"_n, eosio::const_mem_fun<averages, uint64_t, &averages::by_type>>> averagestable;
+
+   [[eosio::action]]
+   void setaverage( eosio::name pair, uint64_t id, uint8_t type, uint64_t value ) {
+      require_auth( get_self() );
+      averagestable averages_table( get_self(), pair.value );
+      auto set = [&]( auto& a ) {
+         a.id        = id;
+         a.type      = type;
+         a.value     = value;
+         a.timestamp = eosio::current_time_point();
+      };
+      auto itr = averages_table.find( id );
+      if( itr == averages_table.end() )
+         averages_table.emplace( get_self(), set );
+      else
+         averages_table.modify( itr, get_self(), set );
+   }
+
+   [[eosio::action]]
+   void delaverage( eosio::name pair, uint64_t id ) {
+      require_auth( get_self() );
+      averagestable averages_table( get_self(), pair.value );
+      averages_table.erase( averages_table.require_find( id, "no average with this id" ) );
+   }
+};
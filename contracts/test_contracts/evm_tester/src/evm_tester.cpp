@@ -0,0 +1,51 @@
+#include <eosio/contract.hpp>
+#include <eosio/crypto.hpp>
+#include <eosio/multi_index.hpp>
+#include <eosio/name.hpp>
+
+#include <eosio.evm/tables.hpp>
+
+/// Stands in for `eosio.evm` in the system contract tests: it keeps the EVM accounts and the storage of the
+/// EVM voting contract that the EVM voting actions read, and lets the tests write their rows directly.
+class [[eosio::contract]]
+evm_tester : public eosio::contract {
+public:
+   using contract::contract;
+
+   /// Writes the EVM account `index`
+   [[eosio::action]]
+   void setaccount( uint64_t index, eosio::checksum160 address, eosio::name account ) {
+      require_auth( get_self() );
+      eosio_evm::account_table accounts( get_self(), get_self().value );
+      auto set = [&]( auto& a ) {
+         a.index   = index;
+         a.address = address;
+         a.account = account;
+      };
+      auto itr = accounts.find( index );
+      if( itr == accounts.end() )
+         accounts.emplace( get_self(), set );
+      else
+         accounts.modify( itr, get_self(), set );
+   }
+
+   /// Writes the storage slot `key` of the EVM account `account_index`
+   [[eosio::action]]
+   void setstate( uint64_t account_index, eosio::checksum256 key, eosio::checksum256 value ) {
+      require_auth( get_self() );
+      eosio_evm::account_state_table states( get_self(), account_index );
+      auto states_bykey = states.get_index<"bykey"_n>();
+      auto itr = states_bykey.find( key );
+      if( itr == states_bykey.end() ) {
+         states.emplace( get_self(), [&]( auto& s ) {
+            s.index = states.available_primary_key();
+            s.key   = key;
+            s.value = value;
+         });
+      } else {
+         states_bykey.modify( itr, get_self(), [&]( auto& s ) {
+            s.value = value;
+         });
+      }
+   }
+};
@@ -0,0 +1,26 @@
+#include <eosio/contract.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/// Evaluates the inverse vote weights with the sine of the CDT libm, in WebAssembly, the way the system
+/// contract evaluated them on every vote before they were tabulated in `inverse_vote_weights`. The tests
+/// compare the table with the weights returned by `weights`.
+class [[eosio::contract]]
+vote_weights_tester : public eosio::contract {
+public:
+   using contract::contract;
+
+   /// The weights for 0 to 30 voted producers
+   [[eosio::action]]
+   std::vector<double> weights() {
+      std::vector<double> result{ 0.0 };
+      for( uint32_t amount_voted_producers = 1; amount_voted_producers <= 30; ++amount_voted_producers ) {
+         double percentVoted = double(amount_voted_producers) / 30;
+         double voteWeight = (sin(M_PI * percentVoted - M_PI_2) + 1.0) / 2.0;
+         result.push_back(voteWeight);
+      }
+      return result;
+   }
+};
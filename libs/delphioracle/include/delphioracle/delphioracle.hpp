@@ -188,6 +188,7 @@ CONTRACT delphioracle : public eosio::contract {
      time_point timestamp = NULL_TIME_POINT;
      uint64_t primary_key() const { return id; }
      uint64_t by_timestamp() const { return timestamp.elapsed.to_seconds(); }
+     uint64_t by_type() const { return type; }
 
      static uint8_t get_type(average_types type) {
        return static_cast<uint8_t>(type);
@@ -366,8 +367,10 @@ CONTRACT delphioracle : public eosio::contract {
        indexed_by<"value"_n, const_mem_fun<daily_datapoints, uint64_t, &daily_datapoints::by_value>>,
        indexed_by<"timestamp"_n, const_mem_fun<daily_datapoints, uint64_t, &daily_datapoints::by_timestamp>>> dailydatapointstable;
 
+  // the "type" index is optional, readers can only query it on deployments that maintain it
   typedef eosio::multi_index<"averages"_n, averages,
-        indexed_by<"timestamp"_n, const_mem_fun<averages, uint64_t, &averages::by_timestamp>>> averagestable;
+        indexed_by<"timestamp"_n, const_mem_fun<averages, uint64_t, &averages::by_timestamp>>,
+        indexed_by<"type"_n, const_mem_fun<averages, uint64_t, &averages::by_type>>> averagestable;
 
   typedef eosio::multi_index<"datapoints"_n, datapoints,
       indexed_by<"value"_n, const_mem_fun<datapoints, uint64_t, &datapoints::by_value>>,
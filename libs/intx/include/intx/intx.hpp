@@ -889,6 +889,78 @@ constexpr uint512 operator"" _u512(const char* s) noexcept
     return from_string<uint512>(s);
 }
 
+/// A divisor of at most 64 bits, normalized and with its reciprocal computed ahead of the divisions,
+/// so that dividing by it only takes multiplications. Make divisors known at compile time constexpr.
+struct uint64_divisor
+{
+    uint64_t value;
+    unsigned shift;
+    uint64_t normalized;
+    uint64_t reciprocal;
+};
+
+/// Same result as reciprocal_2by1(), one bit at a time so that it can be evaluated at compile time.
+/// The reciprocal (2^128 - 1) / d - 2^64 is the quotient of {~d, ~0} by d.
+constexpr uint64_t constexpr_reciprocal_2by1(uint64_t d) noexcept
+{
+    uint64_t r = ~d;
+    uint64_t q = 0;
+    for (int i = 0; i < 64; ++i)
+    {
+        const bool carry = (r >> 63) != 0;
+        r = (r << 1) | 1;
+        q <<= 1;
+        if (carry || r >= d)
+        {
+            r -= d;
+            q |= 1;
+        }
+    }
+    return q;
+}
+
+/// The divisor d must not be 0.
+constexpr uint64_divisor make_divisor(uint64_t d) noexcept
+{
+    const auto shift = clz(d);
+    const auto normalized = d << shift;
+    return {d, shift, normalized, constexpr_reciprocal_2by1(normalized)};
+}
+
+template <unsigned N>
+inline div_result<uint<N>> udivrem(const uint<N>& u, const uint64_divisor& d) noexcept
+{
+    constexpr int num_words = int(N / 64);
+    const auto uw = as_words(u);
+    const auto s = d.shift;
+
+    uint<N> q;
+    auto qw = as_words(q);
+
+    // Divide the numerator shifted left as the divisor, one word at a time from the top one.
+    uint64_t r = s ? uw[num_words - 1] >> (64 - s) : 0;
+    for (int j = num_words - 1; j >= 0; --j)
+    {
+        const uint64_t w = s ? (uw[j] << s) | (j > 0 ? uw[j - 1] >> (64 - s) : 0) : uw[j];
+        const auto x = udivrem_2by1({r, w}, d.normalized, d.reciprocal);
+        qw[j] = x.quot;
+        r = x.rem;
+    }
+    return {q, r >> s};
+}
+
+template <unsigned N>
+inline uint<N> operator/(const uint<N>& x, const uint64_divisor& d) noexcept
+{
+    return udivrem(x, d).quot;
+}
+
+template <unsigned N>
+inline uint<N> operator%(const uint<N>& x, const uint64_divisor& d) noexcept
+{
+    return udivrem(x, d).rem;
+}
+
 namespace le  // Conversions to/from LE bytes.
 {
 template <typename IntT, unsigned M>
@@ -447,14 +447,361 @@ namespace rlp {
         }
     };
 
+    // Streaming encoder: a first pass computes the exact length of every item, a second pass writes them
+    // into a single buffer of that size. Items are unsigned integers, uint256_t and byte strings.
+    namespace stream {
+        // Number of bytes of `n` in big endian form without leading zeroes
+        inline size_t significant_bytes(uint64_t n)
+        {
+            size_t len = 0;
+            for (; n != 0; n >>= 8) {
+                ++len;
+            }
+            return len;
+        }
+
+        // Length of the prefix of a buffer or list with a payload of `payload_length` bytes
+        inline size_t header_length(size_t payload_length)
+        {
+            return payload_length < 56 ? 1 : 1 + significant_bytes(payload_length);
+        }
+
+        inline uint8_t* write_header(uint8_t* out, size_t payload_length, uint8_t offset)
+        {
+            if (payload_length < 56) {
+                *out++ = offset + payload_length;
+                return out;
+            }
+            const size_t len = significant_bytes(payload_length);
+            *out++ = offset + 55 + len;
+            for (size_t i = len; i-- > 0;) {
+                *out++ = static_cast<uint8_t>(payload_length >> (i * 8));
+            }
+            return out;
+        }
+
+        // A single byte below 0x80 is its own encoding
+        inline size_t bytes_length(const uint8_t* data, size_t size)
+        {
+            return (size == 1 && data[0] < RLP_bufferLenStart) ? 1 : header_length(size) + size;
+        }
+
+        inline uint8_t* write_bytes(uint8_t* out, const uint8_t* data, size_t size)
+        {
+            if (size == 1 && data[0] < RLP_bufferLenStart) {
+                *out++ = data[0];
+                return out;
+            }
+            out = write_header(out, size, RLP_bufferLenStart);
+            if (size != 0) {
+                std::memcpy(out, data, size);
+            }
+            return out + size;
+        }
+
+        inline size_t item_length(uint64_t n)
+        {
+            return n < RLP_bufferLenStart ? 1 : 1 + significant_bytes(n);
+        }
+
+        inline uint8_t* write_item(uint8_t* out, uint64_t n)
+        {
+            // "positive RLP integers must be represented in big endian binary form
+            // with no leading zeroes", 0 is the empty buffer
+            if (n == 0) {
+                *out++ = RLP_bufferLenStart;
+                return out;
+            }
+            if (n < RLP_bufferLenStart) {
+                *out++ = static_cast<uint8_t>(n);
+                return out;
+            }
+            const size_t len = significant_bytes(n);
+            *out++ = RLP_bufferLenStart + len;
+            for (size_t i = len; i-- > 0;) {
+                *out++ = static_cast<uint8_t>(n >> (i * 8));
+            }
+            return out;
+        }
+
+        // Values that fit in 64 bits, the usual nonce, gas and value fields, take the uint64_t path
+        inline bool fits_uint64(const uint256_t& n)
+        {
+            return n.hi == 0 && n.lo.hi == 0;
+        }
+
+        inline size_t item_length(const uint256_t& n)
+        {
+            if (fits_uint64(n)) {
+                return item_length(n.lo.lo);
+            }
+            return 1 + intx::count_significant_words<uint8_t>(n);
+        }
+
+        inline uint8_t* write_item(uint8_t* out, const uint256_t& n)
+        {
+            if (fits_uint64(n)) {
+                return write_item(out, n.lo.lo);
+            }
+            uint8_t arr[32] = {};
+            intx::be::store(arr, n);
+            const auto n_bytes = intx::count_significant_words<uint8_t>(n);
+            *out++ = RLP_bufferLenStart + n_bytes;
+            std::memcpy(out, arr + 32 - n_bytes, n_bytes);
+            return out + n_bytes;
+        }
+
+        inline size_t item_length(const std::string& s)
+        {
+            return bytes_length(reinterpret_cast<const uint8_t*>(s.data()), s.size());
+        }
+
+        inline uint8_t* write_item(uint8_t* out, const std::string& s)
+        {
+            return write_bytes(out, reinterpret_cast<const uint8_t*>(s.data()), s.size());
+        }
+
+        inline size_t item_length(const std::vector<uint8_t>& bs)
+        {
+            return bytes_length(bs.data(), bs.size());
+        }
+
+        inline uint8_t* write_item(uint8_t* out, const std::vector<uint8_t>& bs)
+        {
+            return write_bytes(out, bs.data(), bs.size());
+        }
+
+        template <size_t N>
+        size_t item_length(const std::array<uint8_t, N>& a)
+        {
+            return bytes_length(a.data(), N);
+        }
+
+        template <size_t N>
+        uint8_t* write_item(uint8_t* out, const std::array<uint8_t, N>& a)
+        {
+            return write_bytes(out, a.data(), N);
+        }
+    }
+
+    // Encodes a single item as is, several items as a list
     template <typename ... Args>
-    static std::string encode(Args&& ... args){
-        RLPValue rlp;
+    static std::string encode(const Args& ... args){
+        static_assert(sizeof...(Args) > 0, "nothing to encode");
+        const size_t payload_length = (stream::item_length(args) + ...);
+        const size_t header_length = sizeof...(Args) > 1 ? stream::header_length(payload_length) : 0;
+
+        std::string out(header_length + payload_length, '\0');
+        uint8_t* p = reinterpret_cast<uint8_t*>(out.data());
         if (sizeof...(Args) > 1) {
-            rlp.set_array();
+            p = stream::write_header(p, payload_length, RLP_listStart);
         }
-        (rlp.encode_single(args), ...);
-        return rlp.write();
+        ((p = stream::write_item(p, args)), ...);
+        return out;
+    }
+
+    // Zero-copy decoder: a view is an offset and a length over the caller's buffer, which must outlive it.
+    // Only canonical encodings are accepted, as the shortest form is the only valid one.
+    class view {
+    public:
+        // Lists nested deeper than this are rejected
+        static constexpr size_t max_depth = 16;
+
+        view() = default;
+
+        // The item must span all of `size` bytes
+        view(const void* data, size_t size, size_t depth = 0)
+        : _data(static_cast<const uint8_t*>(data)), _depth(depth)
+        {
+            eosio::check(depth <= max_depth, "Invalid Transaction: RLP nested too deep");
+            eosio::check(read_header(_data, size), "Invalid Transaction: RLP could not be decoded");
+            eosio::check(_header_size + _payload_size == size, "Invalid Transaction: RLP has trailing bytes");
+        }
+
+        bool is_list() const { return _list; }
+
+        // Encoding of the item, header included
+        const uint8_t* data() const { return _data; }
+        size_t encoded_size() const { return _header_size + _payload_size; }
+
+        // Bytes of a buffer, encoded items of a list
+        const uint8_t* payload() const { return _data + _header_size; }
+        size_t payload_size() const { return _payload_size; }
+
+        std::string_view bytes() const
+        {
+            eosio::check(!_list, "Invalid Transaction: RLP buffer expected");
+            return std::string_view(reinterpret_cast<const char*>(payload()), _payload_size);
+        }
+
+        uint64_t to_uint64() const
+        {
+            check_integer(sizeof(uint64_t));
+            uint64_t n = 0;
+            for (size_t i = 0; i < _payload_size; ++i) {
+                n = (n << 8) | payload()[i];
+            }
+            return n;
+        }
+
+        uint256_t to_uint256() const
+        {
+            check_integer(32);
+            uint8_t arr[32] = {};
+            std::memcpy(arr + 32 - _payload_size, payload(), _payload_size);
+            return intx::be::load<uint256_t>(arr);
+        }
+
+        class iterator;
+
+        iterator begin() const;
+        iterator end() const;
+
+        // Number of items of a list
+        size_t size() const;
+
+        const view operator[](size_t index) const;
+
+    private:
+        // Big endian length of `len` bytes, without leading zeroes
+        static bool read_length(const uint8_t* raw, size_t len, size_t& out)
+        {
+            if (len > RLP_maxUintLen || raw[0] == 0) {
+                return false;
+            }
+            uint64_t n = 0;
+            for (size_t i = 0; i < len; ++i) {
+                n = (n << 8) | raw[i];
+            }
+            // lengths below 56 must use the short form, size_t is 32 bits wide in contracts
+            if (n < 56 || static_cast<size_t>(n) != n) {
+                return false;
+            }
+            out = n;
+            return true;
+        }
+
+        // Reads the header of the item at `raw`, which has to fit in `size` bytes
+        bool read_header(const uint8_t* raw, size_t size)
+        {
+            if (size == 0) {
+                return false;
+            }
+            const uint8_t ch = raw[0];
+            if (ch < RLP_bufferLenStart) {
+                _list = false;
+                _header_size = 0;
+                _payload_size = 1;
+            } else if (ch <= 0xb7) {
+                _list = false;
+                _header_size = 1;
+                _payload_size = ch - RLP_bufferLenStart;
+                // a single byte below 0x80 is its own encoding
+                if (_payload_size == 1 && (size < 2 || raw[1] < RLP_bufferLenStart)) {
+                    return false;
+                }
+            } else if (ch < RLP_listStart) {
+                _list = false;
+                _header_size = 1 + (ch - 0xb7);
+                if (size < _header_size || !read_length(raw + 1, _header_size - 1, _payload_size)) {
+                    return false;
+                }
+            } else if (ch <= 0xf7) {
+                _list = true;
+                _header_size = 1;
+                _payload_size = ch - RLP_listStart;
+            } else {
+                _list = true;
+                _header_size = 1 + (ch - 0xf7);
+                if (size < _header_size || !read_length(raw + 1, _header_size - 1, _payload_size)) {
+                    return false;
+                }
+            }
+            _data = raw;
+            return _header_size <= size && _payload_size <= size - _header_size;
+        }
+
+        // Integers are big endian buffers without leading zeroes, 0 is the empty buffer
+        void check_integer(size_t max_bytes) const
+        {
+            eosio::check(!_list, "Invalid Transaction: RLP integer expected");
+            eosio::check(_payload_size <= max_bytes, "Invalid Transaction: RLP integer too large");
+            eosio::check(_payload_size == 0 || payload()[0] != 0, "Invalid Transaction: RLP integer has leading zeroes");
+        }
+
+        const uint8_t* _data = nullptr;
+        size_t         _header_size = 0;
+        size_t         _payload_size = 0;
+        size_t         _depth = 0;
+        bool           _list = false;
+    };
+
+    // Iterates over the items of a list, each item is checked as it is reached
+    class view::iterator {
+    public:
+        iterator(const uint8_t* pos, const uint8_t* end, size_t depth)
+        : _pos(pos), _end(end), _depth(depth)
+        {
+            load();
+        }
+
+        const view& operator*() const { return _item; }
+        const view* operator->() const { return &_item; }
+
+        iterator& operator++()
+        {
+            _pos += _item.encoded_size();
+            load();
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const { return _pos == other._pos; }
+        bool operator!=(const iterator& other) const { return _pos != other._pos; }
+
+    private:
+        // The item at `_pos` must fit in what is left of the list
+        void load()
+        {
+            if (_pos == _end) {
+                return;
+            }
+            view header;
+            eosio::check(header.read_header(_pos, _end - _pos), "Invalid Transaction: RLP could not be decoded");
+            _item = view(_pos, header.encoded_size(), _depth);
+        }
+
+        const uint8_t* _pos;
+        const uint8_t* _end;
+        size_t         _depth;
+        view           _item;
+    };
+
+    inline view::iterator view::begin() const
+    {
+        eosio::check(_list, "Invalid Transaction: RLP list expected");
+        return iterator(payload(), payload() + _payload_size, _depth + 1);
+    }
+
+    inline view::iterator view::end() const
+    {
+        return iterator(payload() + _payload_size, payload() + _payload_size, _depth + 1);
+    }
+
+    inline size_t view::size() const
+    {
+        size_t count = 0;
+        for (auto it = begin(); it != end(); ++it) {
+            ++count;
+        }
+        return count;
+    }
+
+    inline const view view::operator[](size_t index) const
+    {
+        auto it = begin();
+        for (; it != end() && index > 0; ++it, --index) {}
+        eosio::check(it != end(), "Invalid Transaction: RLP index out of range");
+        return *it;
     }
 
     static RLPValue decode(std::vector<int8_t> bytes){
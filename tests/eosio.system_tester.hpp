@@ -695,6 +695,56 @@ public:
       vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, "payrate"_n, "payrate"_n );
       return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "payrates", data, abi_serializer_max_time );
    }
+
+   fc::variant get_producer_counters( const account_name& act ) {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, "prodcounters"_n, act );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "producer_counters", data, abi_serializer_max_time );
+   }
+
+   fc::variant get_snapshot_state() {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, "snapshot"_n, "snapshot"_n );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "snapshot_state", data, abi_serializer_max_time );
+   }
+
+   fc::variant get_price_cache() {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, "pricecache"_n, "pricecache"_n );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "price_cache", data, abi_serializer_max_time );
+   }
+
+   // Deploys the evm_tester contract as eosio.evm, with the EVM voting contract at the EVM account index 0 and
+   // the EVM account of the system account at index 1, and makes it the EVM voting contract
+   void setup_evm_voting() {
+      const std::string voting_contract = "00000000000000000000000000000000000000aa";
+      create_account_with_resources( "eosio.evm"_n, config::system_account_name, core_sym::from_string("10.0000"), false );
+      set_code( "eosio.evm"_n, system_contracts::testing::test_contracts::evm_tester_wasm() );
+      set_abi( "eosio.evm"_n, system_contracts::testing::test_contracts::evm_tester_abi().data() );
+      base_tester::push_action( "eosio.evm"_n, "setaccount"_n, "eosio.evm"_n, mvo()
+                                ("index", 0)("address", voting_contract)("account", name()) );
+      base_tester::push_action( "eosio.evm"_n, "setaccount"_n, "eosio.evm"_n, mvo()
+                                ("index", 1)("address", "00000000000000000000000000000000000000bb")("account", config::system_account_name) );
+      BOOST_REQUIRE_EQUAL( success(), push_action( config::system_account_name, "setvotecontr"_n, mvo()("contract", voting_contract) ) );
+   }
+
+   // Stores `value` in the storage slot `key` of the EVM voting contract
+   void set_evm_voting_state( const std::string& key, const std::string& value ) {
+      base_tester::push_action( "eosio.evm"_n, "setstate"_n, "eosio.evm"_n, mvo()
+                                ("account_index", 0)("key", key)("value", value) );
+   }
+
+   fc::variant get_evm_slot_keys( const account_name& bp ) {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, "evmslotkeys"_n, bp );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "evm_slot_keys", data, abi_serializer_max_time );
+   }
+
+   fc::variant get_evm_vote_sync_state() {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, "evmvotesync"_n, "evmvotesync"_n );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "evm_vote_sync_state", data, abi_serializer_max_time );
+   }
+
+   fc::variant get_recalc_state() {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, "recalcstate"_n, "recalcstate"_n );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "recalc_state", data, abi_serializer_max_time );
+   }
    // TELOS END
 
    fc::variant get_rex_pool() const {
@@ -918,7 +968,16 @@ public:
 
    fc::variant get_producer_info( const account_name& act ) {
       vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, "producers"_n, act );
-      return abi_ser.binary_to_variant( "producer_info", data, abi_serializer::create_yield_function(abi_serializer_max_time) );
+      // TELOS BEGIN
+      fc::mutable_variant_object prod( abi_ser.binary_to_variant( "producer_info", data, abi_serializer::create_yield_function(abi_serializer_max_time) ).get_object() );
+      // the block counters of migrated producers live in the prodcounters table
+      const fc::variant counters = get_producer_counters( act );
+      if( !counters.is_null() ) {
+         for( const auto& field : { "unpaid_blocks", "lifetime_produced_blocks", "missed_blocks_per_rotation", "lifetime_missed_blocks" } )
+            prod.set( field, counters[field] );
+      }
+      return prod;
+      // TELOS END
    }
    fc::variant get_producer_info( std::string_view act ) {
       return get_producer_info( account_name(act) );
@@ -0,0 +1,48 @@
+#include <boost/test/unit_test.hpp>
+#include <fc/exception/exception.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+// The EVM libraries are written for contracts, `eosio::check` is the only CDT function they need
+namespace eosio {
+   inline void check( bool pred, const std::string& msg ) {
+      if( !pred ) throw std::runtime_error( msg );
+   }
+}
+
+#include <intx/intx.hpp>
+
+using intx::operator"" _u256;
+
+// both are folded at compile time
+static_assert( 1000000000000000000_u256 == intx::uint256{ 1'000'000'000'000'000'000ULL } );
+static_assert( intx::make_divisor( 100000000000000ULL ).shift == 17 );
+
+BOOST_AUTO_TEST_SUITE(intx_tests)
+
+BOOST_AUTO_TEST_CASE(constant_divisor_matches_division) try {
+   std::mt19937_64 rng( 24 );
+   const uint64_t constants[] = { 1, 2, 3, 100, 31'536'000ULL, 100'000'000'000'000ULL, 1ULL << 63, ~uint64_t( 0 ) };
+   for( const uint64_t c : constants ) {
+      const auto d = intx::make_divisor( c );
+      BOOST_REQUIRE_EQUAL( intx::reciprocal_2by1( d.normalized ), d.reciprocal );
+   }
+   for( int i = 0; i < 20000; ++i ) {
+      const intx::uint256 x = intx::uint256{ intx::uint128{ rng(), rng() }, intx::uint128{ rng(), rng() } } >> unsigned( rng() % 256 );
+      const uint64_t c = i < 8 ? constants[i] : ( rng() >> ( rng() % 64 ) ) | 1;
+      const auto d = intx::make_divisor( c );
+      // the quotient and remainder of the division, without using the generic one
+      const intx::uint256 q = x / d;
+      const intx::uint256 r = x % d;
+      BOOST_REQUIRE( r < intx::uint256{ c } );
+      BOOST_REQUIRE( q * intx::uint256{ c } + r == x );
+   }
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,125 @@
+#include <boost/test/unit_test.hpp>
+#include <fc/exception/exception.hpp>
+
+#include <eosio.system/inverse_vote_weights.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+   uint64_t bits( double d ) {
+      uint64_t b;
+      std::memcpy( &b, &d, sizeof( b ) );
+      return b;
+   }
+
+   uint32_t high_word( double d ) {
+      return uint32_t( bits( d ) >> 32 );
+   }
+
+   // The sine of the CDT libm, which is musl's port of fdlibm, for |x| <= 3π/4. The host libm may round
+   // differently, so the kernels are reproduced here with their constants and operation order. WebAssembly
+   // evaluates doubles without extended precision, like the host does with SSE2.
+   namespace cdt_libm {
+      // __sin, sin on [-π/4, π/4], y the tail of x
+      double kernel_sin( double x, double y, int iy ) {
+         constexpr double S1 = -0x1.5555555555549p-3, S2 = 0x1.111111110f8a6p-7, S3 = -0x1.a01a019c161d5p-13,
+                          S4 = 0x1.71de357b1fe7dp-19, S5 = -0x1.ae5e68a2b9cebp-26, S6 = 0x1.5d93a5acfd57cp-33;
+         const double z = x * x;
+         const double w = z * z;
+         const double r = S2 + z * ( S3 + z * S4 ) + z * w * ( S5 + z * S6 );
+         const double v = z * x;
+         if( iy == 0 )
+            return x + v * ( S1 + z * r );
+         return x - ( ( z * ( 0.5 * y - v * r ) - y ) - v * S1 );
+      }
+
+      // __cos, cos on [-π/4, π/4], y the tail of x
+      double kernel_cos( double x, double y ) {
+         constexpr double C1 = 0x1.555555555554cp-5, C2 = -0x1.6c16c16c15177p-10, C3 = 0x1.a01a019cb159p-16,
+                          C4 = -0x1.27e4f809c52adp-22, C5 = 0x1.1ee9ebdb4b1c4p-29, C6 = -0x1.8fae9be8838d4p-37;
+         const double z = x * x;
+         double w = z * z;
+         const double r = z * ( C1 + z * ( C2 + z * C3 ) ) + w * w * ( C4 + z * ( C5 + z * C6 ) );
+         const double hz = 0.5 * z;
+         w = 1.0 - hz;
+         return w + ( ( ( 1.0 - w ) - hz ) + ( z * r - x * y ) );
+      }
+
+      // __rem_pio2, x = n·π/2 + y[0] + y[1] for π/4 < |x| <= 3π/4, so n is ±1
+      int rem_pio2( double x, double* y ) {
+         constexpr double toint   = 0x1.8p52,
+                          invpio2 = 0x1.45f306dc9c883p-1,
+                          pio2_1  = 0x1.921fb544p+0,  pio2_1t = 0x1.0b4611a626331p-34,
+                          pio2_2  = 0x1.0b4611a6p-34, pio2_2t = 0x1.3198a2e037073p-69,
+                          pio2_3  = 0x1.3198a2ep-69,  pio2_3t = 0x1.b839a252049c1p-104;
+         const uint32_t ix = high_word( x ) & 0x7fffffff;
+         if( ( ix & 0xfffff ) != 0x921fb ) {
+            // no cancellation, one round good to 85 bits
+            if( x > 0 ) {
+               const double z = x - pio2_1;
+               y[0] = z - pio2_1t;
+               y[1] = ( z - y[0] ) - pio2_1t;
+               return 1;
+            }
+            const double z = x + pio2_1;
+            y[0] = z + pio2_1t;
+            y[1] = ( z - y[0] ) + pio2_1t;
+            return -1;
+         }
+
+         // |x| ~= π/2, rounds until the reduced argument is good to 151 bits
+         const double fn = x * invpio2 + toint - toint;
+         double r = x - fn * pio2_1;
+         double w = fn * pio2_1t;
+         y[0] = r - w;
+         const int ex = int( ix >> 20 );
+         if( ex - int( bits( y[0] ) >> 52 & 0x7ff ) > 16 ) {
+            double t = r;
+            w = fn * pio2_2;
+            r = t - w;
+            w = fn * pio2_2t - ( ( t - r ) - w );
+            y[0] = r - w;
+            if( ex - int( bits( y[0] ) >> 52 & 0x7ff ) > 49 ) {
+               t = r;
+               w = fn * pio2_3;
+               r = t - w;
+               w = fn * pio2_3t - ( ( t - r ) - w );
+               y[0] = r - w;
+            }
+         }
+         y[1] = ( r - y[0] ) - w;
+         return int( fn );
+      }
+
+      double sin( double x ) {
+         const uint32_t ix = high_word( x ) & 0x7fffffff;
+         if( ix <= 0x3fe921fb ) {   // |x| ~<= π/4
+            if( ix < 0x3e500000 )   // |x| < 2⁻²⁶
+               return x;
+            return kernel_sin( x, 0.0, 0 );
+         }
+         BOOST_REQUIRE( ix <= 0x4002d97c );   // |x| ~<= 3π/4
+         double y[2];
+         return rem_pio2( x, y ) > 0 ? kernel_cos( y[0], y[1] ) : -kernel_cos( y[0], y[1] );
+      }
+   }
+}
+
+BOOST_AUTO_TEST_SUITE(inverse_vote_weights_tests)
+
+// The table replaces the formula the contract evaluated with the CDT sine on every vote, so every entry
+// must be its bit exact result
+BOOST_AUTO_TEST_CASE(table_matches_cdt_sine) try {
+   BOOST_REQUIRE_EQUAL( 0u, bits( eosiosystem::inverse_vote_weights[0] ) );
+   for( uint32_t amount_voted_producers = 1; amount_voted_producers < eosiosystem::inverse_vote_weights.size(); ++amount_voted_producers ) {
+      const double percentVoted = double(amount_voted_producers) / 30;
+      const double voteWeight = (cdt_libm::sin(M_PI * percentVoted - M_PI_2) + 1.0) / 2.0;
+      BOOST_TEST_CONTEXT("voted producers " << amount_voted_producers) {
+         BOOST_REQUIRE_EQUAL( bits( voteWeight ), bits( eosiosystem::inverse_vote_weights[amount_voted_producers] ) );
+      }
+   }
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,81 @@
+#include <boost/test/unit_test.hpp>
+#include <fc/exception/exception.hpp>
+
+#include <eosio.system/kick_ranking.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+   struct rank {
+      uint32_t owner;
+      uint32_t missed_blocks_per_rotation;
+      double   total_votes;
+   };
+
+   // Producers kicked by the full sort the partial sort replaced, in kick order
+   std::vector<uint32_t> kicked_with_full_sort( std::vector<rank> prods, uint16_t max_kick_bps, uint32_t threshold ) {
+      std::sort( prods.begin(), prods.end(), eosiosystem::kick_order{} );
+      std::vector<uint32_t> kicked;
+      for( const auto& prod : prods ) {
+         if( prod.missed_blocks_per_rotation > threshold && max_kick_bps > 0 ) {
+            kicked.push_back( prod.owner );
+            max_kick_bps--;
+         } else
+            break;
+      }
+      return kicked;
+   }
+
+   // Producers kicked by update_missed_blocks_per_rotation, in kick order
+   std::vector<uint32_t> kicked_with_partial_sort( std::vector<rank> prods, uint16_t max_kick_bps, uint32_t threshold ) {
+      const auto ranked_end = eosiosystem::rank_kick_candidates( prods, max_kick_bps );
+      std::vector<uint32_t> kicked;
+      for( auto it = prods.begin(); it != ranked_end; ++it ) {
+         if( it->missed_blocks_per_rotation > threshold )
+            kicked.push_back( it->owner );
+         else
+            break;
+      }
+      return kicked;
+   }
+}
+
+BOOST_AUTO_TEST_SUITE(kick_ranking_tests)
+
+BOOST_AUTO_TEST_CASE(ties_broken_by_votes) try {
+   // equal missed blocks, the least voted producer is kicked first
+   const std::vector<rank> prods = {
+      { 1, 40, 300.0 }, { 2, 90, 500.0 }, { 3, 40, 100.0 }, { 4, 90, 200.0 }, { 5, 40, 200.0 }, { 6, 10, 50.0 }
+   };
+   BOOST_REQUIRE( ( std::vector<uint32_t>{ 4, 2, 3 } ) == kicked_with_partial_sort( prods, 3, 20 ) );
+   BOOST_REQUIRE( ( std::vector<uint32_t>{ 4, 2, 3 } ) == kicked_with_full_sort( prods, 3, 20 ) );
+
+   // the threshold stops the kicks before max_kick_bps
+   BOOST_REQUIRE( ( std::vector<uint32_t>{ 4, 2 } ) == kicked_with_partial_sort( prods, 3, 50 ) );
+   // no kick allowed, nothing is ranked
+   BOOST_REQUIRE( kicked_with_partial_sort( prods, 0, 0 ).empty() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_CASE(partial_sort_kicks_as_full_sort) try {
+   std::mt19937_64 rng( 15 );
+   for( int i = 0; i < 20000; ++i ) {
+      // up to 35 scheduled producers, more producers missing blocks than max_kick_bps, few distinct missed
+      // counts so that most ranks are decided by the votes
+      const size_t schedule_size = 1 + rng() % 35;
+      const uint16_t max_kick_bps = uint16_t( schedule_size / 7 );
+      std::vector<rank> prods;
+      for( uint32_t owner = 0; owner < schedule_size; ++owner )
+         if( rng() % 4 )
+            prods.push_back( { owner, uint32_t( 1 + rng() % 4 ) * 25, double( rng() % 1000000 ) * 1e6 + owner } );
+      const uint32_t threshold = uint32_t( rng() % 100 );
+
+      BOOST_TEST_CONTEXT( "schedule size " << schedule_size << ", threshold " << threshold ) {
+         BOOST_REQUIRE( kicked_with_full_sort( prods, max_kick_bps, threshold ) == kicked_with_partial_sort( prods, max_kick_bps, threshold ) );
+      }
+   }
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
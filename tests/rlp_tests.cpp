@@ -0,0 +1,208 @@
+#include <boost/test/unit_test.hpp>
+#include <fc/exception/exception.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The EVM libraries are written for contracts, `eosio::check` is the only CDT function they need
+namespace eosio {
+   inline void check( bool pred, const std::string& msg ) {
+      if( !pred ) throw std::runtime_error( msg );
+   }
+}
+
+#include <intx/intx.hpp>
+#include <rlp/rlp.hpp>
+
+namespace {
+   // Encoding of the items as a list by the `RLPValue` tree
+   template <typename... Args>
+   std::string tree_encode( Args... args ) {
+      rlp::RLPValue rlp;
+      rlp.set_array();
+      (rlp.encode_single( args ), ...);
+      return rlp.write();
+   }
+
+   // Same fields as the EVM transactions sent by `setbpevmstat`
+   struct evm_tx {
+      uint256_t                nonce;
+      uint256_t                gas_limit;
+      std::array<uint8_t, 20>  to;
+      std::array<uint8_t, 36>  data;
+   };
+
+   evm_tx random_tx( std::mt19937_64& rng ) {
+      evm_tx tx{ uint256_t( rng() >> ( rng() % 64 ) ), uint256_t( rng() % 1000000 ), {}, {} };
+      for( auto& b : tx.to ) b = rng();
+      for( size_t i = 0; i < 4; ++i ) tx.data[i] = rng();
+      for( size_t i = 28; i < tx.data.size(); ++i ) tx.data[i] = rng();
+      return tx;
+   }
+
+   std::string from_hex( std::string_view hex ) {
+      std::string bytes;
+      for( size_t i = 0; i + 1 < hex.size(); i += 2 )
+         bytes.push_back( char( std::stoi( std::string( hex.substr( i, 2 ) ), nullptr, 16 ) ) );
+      return bytes;
+   }
+
+   bool decodes( const std::string& bytes ) {
+      try {
+         rlp::view item( bytes.data(), bytes.size() );
+         // walk every list down to its leaves
+         std::vector<rlp::view> pending{ item };
+         while( !pending.empty() ) {
+            auto next = pending.back();
+            pending.pop_back();
+            if( next.is_list() )
+               for( const auto& child : next )
+                  pending.push_back( child );
+         }
+         return true;
+      } catch( const std::runtime_error& ) {
+         return false;
+      }
+   }
+}
+
+BOOST_AUTO_TEST_SUITE(rlp_tests)
+
+BOOST_AUTO_TEST_CASE(streaming_encoder_known_vectors) try {
+   // examples of the Ethereum RLP specification
+   BOOST_REQUIRE_EQUAL( std::string( "\x83" "dog" ), rlp::encode( std::string( "dog" ) ) );
+   BOOST_REQUIRE_EQUAL( std::string( "\xc8\x83" "cat" "\x83" "dog" ), rlp::encode( std::string( "cat" ), std::string( "dog" ) ) );
+   BOOST_REQUIRE_EQUAL( std::string( "\x80" ), rlp::encode( std::string() ) );
+   BOOST_REQUIRE_EQUAL( std::string( "\x80" ), rlp::encode( uint64_t( 0 ) ) );
+   BOOST_REQUIRE_EQUAL( std::string( "\x0f" ), rlp::encode( uint64_t( 15 ) ) );
+   BOOST_REQUIRE_EQUAL( std::string( "\x82\x04\x00", 3 ), rlp::encode( uint64_t( 1024 ) ) );
+   BOOST_REQUIRE_EQUAL( std::string( "\x82\x04\x00", 3 ), rlp::encode( uint256_t( 1024 ) ) );
+
+   const std::string lorem = "Lorem ipsum dolor sit amet, consectetur adipisicing elit";
+   BOOST_REQUIRE_EQUAL( std::string( "\xb8\x38" ) + lorem, rlp::encode( lorem ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_CASE(streaming_encoder_matches_tree_encoder) try {
+   std::mt19937_64 rng( 21 );
+   for( int i = 0; i < 20000; ++i ) {
+      // values of every significant length, including 0 and the single bytes below 0x80
+      const uint256_t big = i % 17 == 0 ? uint256_t( 0 ) : uint256_t( rng() ) << ( rng() % 193 );
+      const uint64_t  small = rng() >> ( rng() % 64 );
+      const uint8_t   byte = rng();
+      std::vector<uint8_t> bytes( rng() % 300 );
+      for( auto& b : bytes ) b = rng();
+      const std::string text( rng() % 3, char( rng() ) );
+      const auto tx = random_tx( rng );
+
+      BOOST_REQUIRE_EQUAL( tree_encode( tx.nonce, uint256_t( 0 ), tx.gas_limit, tx.to, uint256_t( 0 ), tx.data, uint8_t( 0 ), uint256_t( 0 ), uint256_t( 0 ) ),
+                           rlp::encode( tx.nonce, uint256_t( 0 ), tx.gas_limit, tx.to, uint256_t( 0 ), tx.data, uint8_t( 0 ), uint256_t( 0 ), uint256_t( 0 ) ) );
+      BOOST_REQUIRE_EQUAL( tree_encode( big, small, byte, bytes, text ), rlp::encode( big, small, byte, bytes, text ) );
+      BOOST_REQUIRE_EQUAL( tree_encode( byte, text ), rlp::encode( byte, text ) );
+   }
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_CASE(streaming_encoder_benchmark) try {
+   std::mt19937_64 rng( 23 );
+   std::vector<evm_tx> txs;
+   for( int i = 0; i < 1000; ++i )
+      txs.push_back( random_tx( rng ) );
+
+   // timings are reported, not checked, they depend on the host
+   auto ns_per_op = [&]( auto&& encode ) {
+      constexpr int rounds = 20;
+      size_t bytes = 0;
+      const auto start = std::chrono::steady_clock::now();
+      for( int r = 0; r < rounds; ++r )
+         for( const auto& tx : txs )
+            bytes += encode( tx ).size();
+      const auto elapsed = std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now() - start ).count();
+      BOOST_REQUIRE_GT( bytes, 0u );
+      return elapsed / ( rounds * txs.size() );
+   };
+   const double tree = ns_per_op( []( const evm_tx& tx ) {
+      return tree_encode( tx.nonce, uint256_t( 0 ), tx.gas_limit, tx.to, uint256_t( 0 ), tx.data, uint8_t( 0 ), uint256_t( 0 ), uint256_t( 0 ) );
+   });
+   const double streaming = ns_per_op( []( const evm_tx& tx ) {
+      return rlp::encode( tx.nonce, uint256_t( 0 ), tx.gas_limit, tx.to, uint256_t( 0 ), tx.data, uint8_t( 0 ), uint256_t( 0 ), uint256_t( 0 ) );
+   });
+   BOOST_TEST_MESSAGE( "rlp encode of an EVM transaction: tree " << tree << " ns/op, streaming " << streaming << " ns/op" );
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_CASE(view_decoder_reads_encoded_transactions) try {
+   std::mt19937_64 rng( 22 );
+   for( int i = 0; i < 2000; ++i ) {
+      const auto tx = random_tx( rng );
+      const uint256_t value = uint256_t( rng() ) << ( rng() % 193 );
+      const std::string encoded = rlp::encode( tx.nonce, uint256_t( 0 ), tx.gas_limit, tx.to, value, tx.data, uint8_t( 0 ), uint256_t( 0 ), uint256_t( 0 ) );
+
+      const rlp::view item( encoded.data(), encoded.size() );
+      BOOST_REQUIRE( item.is_list() );
+      BOOST_REQUIRE_EQUAL( 9u, item.size() );
+      BOOST_REQUIRE_EQUAL( encoded.size(), item.encoded_size() );
+      BOOST_REQUIRE( tx.nonce == item[0].to_uint256() );
+      BOOST_REQUIRE_EQUAL( uint64_t( tx.gas_limit ), item[2].to_uint64() );
+      BOOST_REQUIRE( std::string_view( reinterpret_cast<const char*>( tx.to.data() ), tx.to.size() ) == item[3].bytes() );
+      BOOST_REQUIRE( value == item[4].to_uint256() );
+      BOOST_REQUIRE( std::string_view( reinterpret_cast<const char*>( tx.data.data() ), tx.data.size() ) == item[5].bytes() );
+      BOOST_REQUIRE_EQUAL( 0u, item[8].to_uint64() );
+
+      // the items point into the encoded transaction, nothing is copied
+      BOOST_REQUIRE( item[5].payload() >= reinterpret_cast<const uint8_t*>( encoded.data() ) );
+      BOOST_REQUIRE( item[5].payload() + item[5].payload_size() <= reinterpret_cast<const uint8_t*>( encoded.data() + encoded.size() ) );
+   }
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_CASE(view_decoder_rejects_non_canonical_encodings) try {
+   // canonical encodings of the RLP specification
+   BOOST_REQUIRE( decodes( from_hex( "83646f67" ) ) );
+   BOOST_REQUIRE( decodes( from_hex( "c7c0c1c0c3c0c1c0" ) ) );
+   BOOST_REQUIRE( decodes( from_hex( "7f" ) ) );
+   BOOST_REQUIRE( decodes( from_hex( "8180" ) ) );
+
+   // a single byte below 0x80 is its own encoding
+   BOOST_REQUIRE( !decodes( from_hex( "8100" ) ) );
+   BOOST_REQUIRE( !decodes( from_hex( "817f" ) ) );
+   // long forms of lengths below 56
+   BOOST_REQUIRE( !decodes( from_hex( "b803646f67" ) ) );
+   BOOST_REQUIRE( !decodes( from_hex( "f801c0" ) ) );
+   // leading zeroes in a length
+   BOOST_REQUIRE( !decodes( from_hex( "b90038" ) + std::string( 56, 'a' ) ) );
+   // truncated items and trailing bytes
+   BOOST_REQUIRE( !decodes( from_hex( "" ) ) );
+   BOOST_REQUIRE( !decodes( from_hex( "83646f" ) ) );
+   BOOST_REQUIRE( !decodes( from_hex( "b838" ) + std::string( 55, 'a' ) ) );
+   BOOST_REQUIRE( !decodes( from_hex( "c583646f67" ) ) );
+   BOOST_REQUIRE( !decodes( from_hex( "83646f6767" ) ) );
+   BOOST_REQUIRE( !decodes( from_hex( "c3646f67" ) + "g" ) );
+   // an item of a list that overruns the list
+   BOOST_REQUIRE( !decodes( from_hex( "c283646f67" ) ) );
+
+   // integers have no leading zeroes, 0 is the empty buffer
+   const std::string zero = from_hex( "00" );
+   BOOST_REQUIRE_THROW( rlp::view( zero.data(), zero.size() ).to_uint64(), std::runtime_error );
+   const std::string padded = from_hex( "820001" );
+   BOOST_REQUIRE_THROW( rlp::view( padded.data(), padded.size() ).to_uint64(), std::runtime_error );
+   const std::string too_large = from_hex( "89010000000000000000" );
+   BOOST_REQUIRE_THROW( rlp::view( too_large.data(), too_large.size() ).to_uint64(), std::runtime_error );
+   BOOST_REQUIRE( uint256_t( 1 ) << 64 == rlp::view( too_large.data(), too_large.size() ).to_uint256() );
+
+   // nesting is bounded
+   std::string nested = from_hex( "c0" );
+   for( size_t depth = 0; depth < rlp::view::max_depth; ++depth )
+      nested = std::string( 1, char( 0xc0 + nested.size() ) ) + nested;
+   BOOST_REQUIRE( decodes( nested ) );
+   nested = std::string( 1, char( 0xc0 + nested.size() ) ) + nested;
+   BOOST_REQUIRE( !decodes( nested ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
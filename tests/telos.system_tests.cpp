@@ -1,7 +1,12 @@
 #include <boost/test/unit_test.hpp>
 #include <cmath>
+#include <cstring>
+#include <map>
+#include <random>
+#include <set>
 
 #include "eosio.system_tester.hpp"
+#include <eosio.system/inverse_vote_weights.hpp>
 
 #define MAX_PRODUCERS 35
 
@@ -310,6 +315,20 @@ BOOST_FIXTURE_TEST_CASE(multi_producer_pay, eosio_system_tester, * boost::unit_t
 
       produce_blocks();
 
+      // the payments of the snapshot are written 12 producers per block
+      BOOST_REQUIRE(!get_snapshot_state().is_null());
+      BOOST_REQUIRE_EQUAL(12, get_snapshot_state()["next_index"].as<uint32_t>());
+      BOOST_REQUIRE_EQUAL(size_t(producer_amount), get_snapshot_state()["producers"].get_array().size());
+      uint32_t snapshot_blocks = 1;
+      while (!get_snapshot_state().is_null()) {
+         produce_blocks();
+         ++snapshot_blocks;
+      }
+      BOOST_REQUIRE_EQUAL(3, snapshot_blocks);
+
+      // no oracle price is available, the fallback price is not cached
+      BOOST_REQUIRE(get_row_by_account(config::system_account_name, config::system_account_name, "pricecache"_n, "pricecache"_n).empty());
+
       const fc::variant pay_rate_info = get_payrate_info();
       const uint64_t bpay_rate = pay_rate_info["bpay_rate"].as<uint64_t>();;
       const uint64_t worker_amount = pay_rate_info["worker_amount"].as<uint64_t>();
@@ -375,7 +394,8 @@ BOOST_FIXTURE_TEST_CASE(multi_producer_pay, eosio_system_tester, * boost::unit_t
       for(const auto &prod : producer_infos) {
          if(producer_count < producer_amount && prod["is_active"].as<bool>()) {
             index++;
-            BOOST_REQUIRE_EQUAL(0, prod["unpaid_blocks"].as<uint32_t>());
+            // only blocks produced after its payment was written are left unpaid
+            BOOST_REQUIRE_LT(prod["unpaid_blocks"].as<uint32_t>(), snapshot_blocks);
             const fc::variant payout_info = get_payment_info(prod["owner"].as<name>());
             BOOST_REQUIRE(!payout_info.is_null());
             const asset payment = payout_info["pay"].as<asset>();
@@ -392,7 +412,7 @@ BOOST_FIXTURE_TEST_CASE(multi_producer_pay, eosio_system_tester, * boost::unit_t
             }
             expected_payments.push_back(asset(expected_pay, symbol{CORE_SYM}));
          } else {
-            BOOST_REQUIRE_EQUAL(0, prod["unpaid_blocks"].as<uint32_t>());
+            BOOST_REQUIRE_LT(prod["unpaid_blocks"].as<uint32_t>(), snapshot_blocks);
             const asset balance = get_balance(prod["owner"].as<name>());
             BOOST_REQUIRE(get_payment_info(prod["owner"].as<name>()).is_null());
             BOOST_REQUIRE_EQUAL(wasm_assert_msg("No payment exists for account"),
@@ -427,7 +447,7 @@ BOOST_FIXTURE_TEST_CASE(multi_producer_pay, eosio_system_tester, * boost::unit_t
          BOOST_REQUIRE_EQUAL(claim_time, microseconds_since_epoch_of_iso_string( prod_info["last_claim_time"] ));
       }
 
-      BOOST_REQUIRE_EQUAL(0, tot_unpaid_blocks);
+      BOOST_REQUIRE_LT(tot_unpaid_blocks, snapshot_blocks);
 
       BOOST_REQUIRE_EQUAL(get_balance("works.decide"_n), initial_wps_balance + to_wps);
       const asset supply  = get_token_supply();
@@ -435,4 +455,815 @@ BOOST_FIXTURE_TEST_CASE(multi_producer_pay, eosio_system_tester, * boost::unit_t
    }
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(untouched_state_skips_singleton_writes, eosio_system_tester) try {
+   namespace chain = eosio::chain;
+   // the network is not activated, onblock only counts the block in global and global2
+   const std::vector<name> untouched_by_onblock = {
+      "global3"_n, "global4"_n, "schedulemetr"_n, "rotations"_n, "payrate"_n, "votingconfig"_n
+   };
+   // tables of eosio with a row updated in the pending block, read from its undo session like the state
+   // history deltas are, so that a row rewritten with identical bytes is still seen
+   auto updated_tables = [&]() {
+      std::set<name> tables;
+      const auto& db = control->db();
+      const auto undo = db.get_index<chain::key_value_index>().last_undo_session();
+      for( const auto& old : undo.old_values ) {
+         const auto& t_id = db.get<chain::table_id_object>( old.t_id );
+         if( t_id.code == config::system_account_name && t_id.scope == config::system_account_name )
+            tables.insert( t_id.table );
+      }
+      return tables;
+   };
+   auto setpayrates = [&]( uint64_t bpay, uint64_t worker ) {
+      produce_block();
+      base_tester::push_action( config::system_account_name, "setpayrates"_n, config::system_account_name,
+                                mvo()("inflation", bpay)("worker", worker) );
+      return updated_tables();
+   };
+
+   const fc::variant pay_rate_info = get_payrate_info();
+   const uint64_t bpay_rate = pay_rate_info["bpay_rate"].as<uint64_t>();
+   const uint64_t worker_amount = pay_rate_info["worker_amount"].as<uint64_t>();
+   produce_blocks(2);
+
+   // same pay rates, none of the cached singletons is written back
+   auto updated = setpayrates( bpay_rate, worker_amount );
+   for( const auto& table : untouched_by_onblock )
+      BOOST_REQUIRE_MESSAGE( updated.count( table ) == 0, table.to_string() + " was written back" );
+
+   // new pay rates, only the payrate singleton is written back
+   updated = setpayrates( bpay_rate - 1, worker_amount );
+   BOOST_REQUIRE_EQUAL( 1u, updated.count( "payrate"_n ) );
+   for( const auto& table : untouched_by_onblock )
+      if( table != "payrate"_n )
+         BOOST_REQUIRE_MESSAGE( updated.count( table ) == 0, table.to_string() + " was written back" );
+   BOOST_REQUIRE_EQUAL( bpay_rate - 1, get_payrate_info()["bpay_rate"].as<uint64_t>() );
+
+   // the other setters, setting the current value again writes nothing back
+   auto setselfstake = [&]( uint64_t multiplier ) {
+      produce_block();
+      BOOST_REQUIRE_EQUAL( success(), push_action( config::system_account_name, "setselfstake"_n,
+                                                   mvo()("self_stake_boost_multiplier", multiplier) ) );
+      return updated_tables();
+   };
+   BOOST_REQUIRE_EQUAL( 1u, setselfstake( 10 ).count( "votingconfig"_n ) );
+   BOOST_REQUIRE_EQUAL( 0u, setselfstake( 10 ).count( "votingconfig"_n ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(paginated_vote_recalculation, eosio_system_tester, * boost::unit_test::tolerance(1e-8)) try {
+   const asset large_asset = core_sym::from_string("80.0000");
+   const std::vector<account_name> producer_names = { "defproducera"_n, "defproducerb"_n, "defproducerc"_n, "defproducerd"_n, "defproducere"_n };
+   setup_producer_accounts(producer_names);
+   for (const auto& p : producer_names)
+      BOOST_REQUIRE_EQUAL(success(), regproducer(p));
+
+   std::vector<account_name> voters;
+   for ( char c = 'a'; c <= 'h'; ++c ) {
+      voters.emplace_back(std::string("recalcvoter") + c);
+   }
+   for ( size_t i = 0; i < voters.size(); ++i ) {
+      create_account_with_resources( voters[i], config::system_account_name, core_sym::from_string("1.0000"), false, large_asset, large_asset );
+      transfer(config::system_account_name, voters[i], core_sym::from_string("2000.0000"), config::system_account_name);
+      BOOST_REQUIRE_EQUAL(success(), stake(voters[i], core_sym::from_string("500.0000"), core_sym::from_string("500.0000")));
+      BOOST_REQUIRE_EQUAL(success(), vote(voters[i], vector<account_name>(producer_names.begin(), producer_names.begin() + 1 + i % producer_names.size())));
+   }
+   produce_blocks(1);
+
+   auto recalcvotes = [&]( const account_name& user, uint16_t max ) {
+      return push_action( user, "recalcvotes"_n, mvo()("user", user)("max", max) );
+   };
+   auto producer_votes = [&]() {
+      std::vector<double> votes;
+      for (const auto& p : producer_names)
+         votes.push_back(get_producer_info(p)["total_votes"].as<double>());
+      return votes;
+   };
+   auto check_totals = [&]( const std::vector<double>& expected ) {
+      const auto votes = producer_votes();
+      double total = 0;
+      for ( size_t i = 0; i < producer_names.size(); ++i ) {
+         BOOST_TEST(votes[i] == expected[i]);
+         total += votes[i];
+      }
+      BOOST_TEST(get_global_state()["total_producer_vote_weight"].as<double>() == total);
+   };
+
+   // only the system account can start a recalculation, anyone can advance it
+   BOOST_REQUIRE_EQUAL(error("missing authority of eosio"), recalcvotes(voters[0], 3));
+   BOOST_REQUIRE(get_recalc_state().is_null());
+
+   const auto votes_before = producer_votes();
+   const int64_t activated_stake_before = get_global_state()["total_activated_stake"].as<int64_t>();
+
+   BOOST_REQUIRE_EQUAL(success(), recalcvotes(config::system_account_name, 3));
+   produce_blocks(1);
+   auto state = get_recalc_state();
+   BOOST_REQUIRE(!state.is_null());
+   BOOST_REQUIRE_EQUAL(3, state["voters_processed"].as<uint64_t>());
+   const name cursor = state["next_voter"].as<name>();
+   BOOST_REQUIRE(cursor != name());
+   // producer totals are not touched until the recalculation completes
+   check_totals(votes_before);
+
+   // advance until the first test voter is recalculated while the last one is still ahead of the cursor
+   auto next_voter = [&]() { return get_recalc_state()["next_voter"].as<name>().to_uint64_t(); };
+   uint64_t processed = 3;
+   while ( next_voter() <= voters.front().to_uint64_t() ) {
+      BOOST_REQUIRE_EQUAL(success(), recalcvotes(voters[0], 1));
+      produce_blocks(1);
+      BOOST_REQUIRE_EQUAL(++processed, get_recalc_state()["voters_processed"].as<uint64_t>());
+   }
+   BOOST_REQUIRE_LE(next_voter(), voters.back().to_uint64_t());
+
+   // interrupted by votes on both sides of the cursor
+   BOOST_REQUIRE_EQUAL(success(), vote(voters.front(), { producer_names[1], producer_names[4] }));
+   BOOST_REQUIRE_EQUAL(success(), vote(voters.back(), { producer_names[0] }));
+   BOOST_REQUIRE_EQUAL(success(), stake(voters[1], core_sym::from_string("100.0000"), core_sym::from_string("100.0000")));
+   produce_blocks(1);
+   const auto votes_interrupted = producer_votes();
+   const int64_t activated_stake_interrupted = get_global_state()["total_activated_stake"].as<int64_t>();
+   BOOST_REQUIRE_EQUAL(activated_stake_before + 200'0000, activated_stake_interrupted);
+
+   // resumed from the stored cursor until done, the swapped totals match the incrementally maintained ones
+   for ( int i = 0; i < 100 && !get_recalc_state().is_null(); ++i ) {
+      BOOST_REQUIRE_EQUAL(success(), recalcvotes(voters[1], 2));
+      produce_blocks(1);
+   }
+   BOOST_REQUIRE(get_recalc_state().is_null());
+   check_totals(votes_interrupted);
+   BOOST_REQUIRE_EQUAL(activated_stake_interrupted, get_global_state()["total_activated_stake"].as<int64_t>());
+   BOOST_REQUIRE_EQUAL(wasm_assert_msg("max must be positive"), recalcvotes(config::system_account_name, 0));
+
+   // once the chain is activated onblock advances a recalculation in progress on its own
+   activate_network();
+   const auto votes_activated = producer_votes();
+   BOOST_REQUIRE_EQUAL(success(), recalcvotes(config::system_account_name, 1));
+   for ( int i = 0; i < 10 && !get_recalc_state().is_null(); ++i ) {
+      produce_blocks(1);
+   }
+   BOOST_REQUIRE(get_recalc_state().is_null());
+   check_totals(votes_activated);
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(producer_counters_split, eosio_system_tester) try {
+   const asset large_asset = core_sym::from_string("80.0000");
+   create_account_with_resources( "defproducera"_n, config::system_account_name, core_sym::from_string("1.0000"), false, large_asset, large_asset );
+   create_account_with_resources( "defproducerb"_n, config::system_account_name, core_sym::from_string("1.0000"), false, large_asset, large_asset );
+   create_account_with_resources( "producvotera"_n, config::system_account_name, core_sym::from_string("1.0000"), false, large_asset, large_asset );
+
+   BOOST_REQUIRE_EQUAL(success(), regproducer("defproducera"_n));
+   transfer(config::system_account_name, "producvotera", core_sym::from_string("400000000.0000"), config::system_account_name);
+   BOOST_REQUIRE_EQUAL(success(), stake("producvotera", core_sym::from_string("100000000.0000"), core_sym::from_string("100000000.0000")));
+   BOOST_REQUIRE_EQUAL(success(), vote( "producvotera"_n, { "defproducera"_n }));
+
+   produce_blocks((1000 - get_global_state()["block_num"].as<uint32_t>()) + 1);
+   produce_blocks(400);
+
+   // onblock only writes the counters row, the producers row keeps the counters it had when migrated
+   auto producer_row = [&]( const account_name& act ) {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, "producers"_n, act );
+      return abi_ser.binary_to_variant( "producer_info", data, abi_serializer_max_time );
+   };
+   const fc::variant counters = get_producer_counters("defproducera"_n);
+   BOOST_REQUIRE(!counters.is_null());
+   const uint32_t unpaid_blocks = counters["unpaid_blocks"].as<uint32_t>();
+   BOOST_REQUIRE(1 < unpaid_blocks);
+   BOOST_REQUIRE_EQUAL(get_global_state()["total_unpaid_blocks"].as<uint32_t>(), unpaid_blocks);
+   BOOST_REQUIRE_EQUAL(unpaid_blocks, counters["lifetime_produced_blocks"].as<uint32_t>());
+   BOOST_REQUIRE_EQUAL(0, producer_row("defproducera"_n)["unpaid_blocks"].as<uint32_t>());
+   BOOST_REQUIRE_EQUAL(0, producer_row("defproducera"_n)["lifetime_produced_blocks"].as<uint32_t>());
+   BOOST_REQUIRE_EQUAL(24u, get_row_by_account( config::system_account_name, config::system_account_name, "prodcounters"_n, "defproducera"_n ).size());
+
+   // getproducer returns the producers row with the current counters
+   auto trace = base_tester::push_action( config::system_account_name, "getproducer"_n, "producvotera"_n, mvo()("owner", "defproducera") );
+   const fc::variant view = abi_ser.binary_to_variant( "producer_info", trace->action_traces[0].return_value, abi_serializer_max_time );
+   BOOST_REQUIRE_EQUAL(unpaid_blocks, view["unpaid_blocks"].as<uint32_t>());
+   BOOST_REQUIRE_EQUAL(unpaid_blocks, view["lifetime_produced_blocks"].as<uint32_t>());
+   BOOST_REQUIRE_EQUAL(producer_row("defproducera"_n)["url"].as_string(), view["url"].as_string());
+   BOOST_REQUIRE_EQUAL(unpaid_blocks, get_producer_info("defproducera"_n)["unpaid_blocks"].as<uint32_t>());
+
+   // producers that never changed a counter are migrated by migcounters
+   BOOST_REQUIRE_EQUAL(success(), regproducer("defproducerb"_n));
+   BOOST_REQUIRE(get_producer_counters("defproducerb"_n).is_null());
+   BOOST_REQUIRE_EQUAL(error("missing authority of eosio"), push_action("defproducerb"_n, "migcounters"_n, mvo()("max", 10)));
+   BOOST_REQUIRE_EQUAL(success(), push_action(config::system_account_name, "migcounters"_n, mvo()("max", 10)));
+   BOOST_REQUIRE_EQUAL(0, get_producer_counters("defproducerb"_n)["unpaid_blocks"].as<uint32_t>());
+   produce_blocks(1);
+   BOOST_REQUIRE_EQUAL(wasm_assert_msg("all producers are already migrated"),
+                       push_action(config::system_account_name, "migcounters"_n, mvo()("max", 10)));
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(schedule_fingerprint_tracks_proposed_schedule, eosio_system_tester) try {
+   auto fingerprint_of = []( const std::vector<account_name>& schedule ) {
+      uint64_t hash = 0;
+      for( const auto& p : schedule ) {
+         uint64_t z = p.to_uint64_t();
+         z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+         z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+         hash += z ^ (z >> 31);
+      }
+      return hash;
+   };
+   auto active_schedule = [&]() {
+      std::vector<account_name> schedule;
+      for( const auto& p : control->active_producers().producers )
+         schedule.push_back( p.producer_name );
+      return schedule;
+   };
+
+   auto producer_names = active_and_vote_producers();
+   produce_blocks( 21 * 12 );
+
+   // the fingerprint of the proposed schedule is kept next to its metrics and matches the active schedule
+   auto metrics = get_gmetrics_state();
+   BOOST_REQUIRE( !metrics["proposed_schedule"].is_null() );
+   std::vector<account_name> proposed;
+   for( const auto& pm : metrics["producers_metric"].get_array() )
+      proposed.push_back( pm["bp_name"].as<account_name>() );
+   BOOST_REQUIRE_EQUAL( proposed.size(), metrics["proposed_schedule"]["size"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( fingerprint_of( proposed ), metrics["proposed_schedule"]["hash"].as<uint64_t>() );
+
+   auto schedule = active_schedule();
+   BOOST_REQUIRE_EQUAL( schedule.size(), proposed.size() );
+   BOOST_REQUIRE_EQUAL( fingerprint_of( schedule ), metrics["proposed_schedule"]["hash"].as<uint64_t>() );
+
+   // the fingerprint does not depend on the order of the producers
+   std::reverse( schedule.begin(), schedule.end() );
+   BOOST_REQUIRE_EQUAL( fingerprint_of( schedule ), metrics["proposed_schedule"]["hash"].as<uint64_t>() );
+
+   // the fingerprint stays in step with the proposed metrics through further elections
+   BOOST_REQUIRE_EQUAL( success(), push_action( "alice1111111"_n, "voteproducer"_n, mvo()
+                                                ("voter",  "alice1111111")
+                                                ("proxy", name(0).to_string())
+                                                ("producers", vector<account_name>(producer_names.begin(), producer_names.begin()+20)) ) );
+   produce_blocks( 21 * 12 );
+   metrics = get_gmetrics_state();
+   BOOST_REQUIRE_EQUAL( metrics["producers_metric"].get_array().size(), metrics["proposed_schedule"]["size"].as<uint32_t>() );
+   proposed.clear();
+   for( const auto& pm : metrics["producers_metric"].get_array() )
+      proposed.push_back( pm["bp_name"].as<account_name>() );
+   BOOST_REQUIRE_EQUAL( fingerprint_of( proposed ), metrics["proposed_schedule"]["hash"].as<uint64_t>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(schedule_metrics_sorted_lookup, eosio_system_tester) try {
+   active_and_vote_producers();
+   produce_blocks( 21 * 12 );
+
+   // the metrics are kept sorted by producer name for the per-block lookups, without any extra storage
+   auto metrics = get_gmetrics_state();
+   const auto& producers_metric = metrics["producers_metric"].get_array();
+   BOOST_REQUIRE_EQUAL( 21u, producers_metric.size() );
+   for( size_t i = 1; i < producers_metric.size(); ++i )
+      BOOST_REQUIRE( producers_metric[i-1]["bp_name"].as<account_name>() < producers_metric[i]["bp_name"].as<account_name>() );
+   // last_onblock_caller + block_counter_correction + producers_metric + proposed_schedule
+   // + proposed_schedule_digest, present once a schedule was proposed
+   BOOST_REQUIRE( !metrics["proposed_schedule_digest"].is_null() );
+   const size_t metrics_size = 8 + 4 + 1 + producers_metric.size() * 12 + 12 + 32;
+   BOOST_REQUIRE_EQUAL( metrics_size, get_row_by_account( config::system_account_name, config::system_account_name, "schedulemetr"_n, "schedulemetr"_n ).size() );
+
+   // the lookups of another round update the producers in place, the order is unchanged
+   std::vector<account_name> names;
+   for( const auto& pm : producers_metric )
+      names.push_back( pm["bp_name"].as<account_name>() );
+   produce_blocks( 21 * 12 );
+   const auto later = get_gmetrics_state();
+   std::vector<account_name> later_names;
+   for( const auto& pm : later["producers_metric"].get_array() )
+      later_names.push_back( pm["bp_name"].as<account_name>() );
+   BOOST_REQUIRE( names == later_names );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(oracle_price_cache, eosio_system_tester) try {
+   // the averages of the delphi oracle, in delphioracle::averages type order
+   const uint8_t last_7_days = 0, last_14_days = 1, last_30_days = 2, last_45_days = 3;
+   const account_name oracle = "delphioracle"_n;
+   create_account_with_resources( oracle, config::system_account_name, core_sym::from_string("10.0000"), false );
+   set_code( oracle, system_contracts::testing::test_contracts::delphioracle_tester_wasm() );
+   set_abi( oracle, system_contracts::testing::test_contracts::delphioracle_tester_abi().data() );
+   auto set_average = [&]( uint64_t id, uint8_t type, uint64_t value ) {
+      base_tester::push_action( oracle, "setaverage"_n, oracle, mvo()("pair", "tlosusd")("id", id)("type", type)("value", value) );
+   };
+   auto erase_average = [&]( uint64_t id ) {
+      base_tester::push_action( oracle, "delaverage"_n, oracle, mvo()("pair", "tlosusd")("id", id) );
+   };
+
+   // the preferred averages come last, a read stopping at the first known type would pick the 7 days one
+   set_average( 0, last_7_days, 700 );
+   set_average( 1, last_45_days, 4500 );
+   set_average( 2, last_14_days, 1400 );
+   set_average( 3, last_30_days, 3000 );
+
+   active_and_vote_producers();
+   BOOST_REQUIRE( get_price_cache().is_null() );
+
+   // skips past the next rewards snapshot and writes its payments
+   auto snapshot_after = [&]( fc::microseconds skip ) {
+      const uint32_t last_claimrewards = get_global_state()["last_claimrewards"].as<uint32_t>();
+      produce_block( skip );
+      produce_blocks();
+      while( !get_snapshot_state().is_null() )
+         produce_blocks();
+      BOOST_REQUIRE_NE( last_claimrewards, get_global_state()["last_claimrewards"].as<uint32_t>() );
+   };
+
+   // the 30 days average is read in one pass over the mixed types and cached
+   snapshot_after( fc::hours(1) );
+   auto cache = get_price_cache();
+   BOOST_REQUIRE( !cache.is_null() );
+   BOOST_REQUIRE_EQUAL( 3000u, cache["price"].as<uint64_t>() );
+   const time_point first_read = cache["updated"].as<time_point>();
+
+   // inside the 6 hours window the cached price is used, the oracle is not read again
+   set_average( 3, last_30_days, 3300 );
+   snapshot_after( fc::hours(1) );
+   snapshot_after( fc::hours(1) );
+   cache = get_price_cache();
+   BOOST_REQUIRE_EQUAL( 3000u, cache["price"].as<uint64_t>() );
+   BOOST_REQUIRE( first_read == cache["updated"].as<time_point>() );
+
+   // once the window expired, the next snapshot reads the oracle again
+   snapshot_after( fc::hours(5) );
+   cache = get_price_cache();
+   BOOST_REQUIRE_EQUAL( 3300u, cache["price"].as<uint64_t>() );
+   BOOST_REQUIRE( first_read + fc::hours(6) <= cache["updated"].as<time_point>() );
+
+   // without a 30 days average the 14 days one is used, then the 7 days one, never the 45 days one
+   erase_average( 3 );
+   snapshot_after( fc::hours(7) );
+   BOOST_REQUIRE_EQUAL( 1400u, get_price_cache()["price"].as<uint64_t>() );
+   erase_average( 2 );
+   snapshot_after( fc::hours(7) );
+   BOOST_REQUIRE_EQUAL( 700u, get_price_cache()["price"].as<uint64_t>() );
+
+   // without any known average the fallback price is not cached, the last price is kept
+   erase_average( 0 );
+   snapshot_after( fc::hours(7) );
+   BOOST_REQUIRE_EQUAL( 700u, get_price_cache()["price"].as<uint64_t>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(rotation_swaps_in_place, eosio_system_tester) try {
+   activate_network();
+   transfer( config::system_account_name, "alice1111111"_n, core_sym::from_string("650000000.0000"), config::system_account_name );
+   BOOST_REQUIRE_EQUAL( success(), stake( "alice1111111"_n, core_sym::from_string("300000000.0000"), core_sym::from_string("300000000.0000") ) );
+
+   // 22 producers with the same votes, ranked by name: defproducerv is the only standby producer
+   std::vector<account_name> producer_names;
+   for ( char c = 'a'; c <= 'v'; ++c )
+      producer_names.emplace_back( std::string("defproducer") + c );
+   setup_producer_accounts( producer_names );
+   for ( const auto& p : producer_names )
+      BOOST_REQUIRE_EQUAL( success(), regproducer(p) );
+   BOOST_REQUIRE_EQUAL( success(), vote( "alice1111111"_n, producer_names ) );
+
+   auto active_schedule = [&]() {
+      std::set<account_name> names;
+      for( const auto& p : control->active_producers().producers )
+         names.insert( p.producer_name );
+      return names;
+   };
+   auto schedule_without = [&]( std::set<account_name> excluded ) {
+      std::set<account_name> names;
+      for( const auto& p : producer_names )
+         if( !excluded.count( p ) )
+            names.insert( p );
+      return names;
+   };
+   auto require_rotation = [&]( account_name bp_out, account_name sbp_in, uint32_t bp_out_index, uint32_t sbp_in_index ) {
+      const auto rotation = get_rotation_state();
+      BOOST_REQUIRE_EQUAL( bp_out, rotation["bp_currently_out"].as<account_name>() );
+      BOOST_REQUIRE_EQUAL( sbp_in, rotation["sbp_currently_in"].as<account_name>() );
+      BOOST_REQUIRE_EQUAL( bp_out_index, rotation["bp_out_index"].as<uint32_t>() );
+      BOOST_REQUIRE_EQUAL( sbp_in_index, rotation["sbp_in_index"].as<uint32_t>() );
+   };
+
+   // the first rotation swaps the first ranked producer with the standby one
+   produce_blocks( 250 );
+   require_rotation( "defproducera"_n, "defproducerv"_n, 0, 21 );
+   BOOST_REQUIRE( schedule_without( { "defproducera"_n } ) == active_schedule() );
+
+   // the next one moves to the second ranked producer, the standby producer is rotated in again
+   produce_block( fc::hours(12) );
+   produce_blocks( 250 );
+   require_rotation( "defproducerb"_n, "defproducerv"_n, 1, 21 );
+   BOOST_REQUIRE( schedule_without( { "defproducerb"_n } ) == active_schedule() );
+
+   // with one producer less, both rotated producers rank inside the 21 of the schedule. Swapping them would
+   // repeat defproducerv: the replaced loop proposed that schedule, which set_proposed_producers rejected. The
+   // ranked producers are now kept as they are, defproducerb stays in the schedule.
+   BOOST_REQUIRE_EQUAL( success(), push_action( "defproducerc"_n, "unregprod"_n, mvo()("producer", "defproducerc") ) );
+   produce_blocks( 250 );
+   require_rotation( "defproducerb"_n, "defproducerv"_n, 1, 21 );
+   BOOST_REQUIRE( schedule_without( { "defproducerc"_n } ) == active_schedule() );
+   BOOST_REQUIRE_EQUAL( 21u, control->active_producers().producers.size() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(whole_unit_vote_weights, eosio_system_tester) try {
+   const asset large_asset = core_sym::from_string("80.0000");
+   const std::vector<account_name> producer_names = { "defproducera"_n, "defproducerb"_n, "defproducerc"_n, "defproducerd"_n };
+   setup_producer_accounts(producer_names);
+   for (const auto& p : producer_names)
+      BOOST_REQUIRE_EQUAL(success(), regproducer(p));
+   BOOST_REQUIRE_EQUAL(success(), push_action(config::system_account_name, "setselfstake"_n, mvo()("self_stake_boost_multiplier", 10)));
+
+   // the producers vote as well, so that the self stake boost is part of the sequences
+   std::vector<account_name> voters = producer_names;
+   for ( char c = 'a'; c <= 'e'; ++c ) {
+      voters.emplace_back(std::string("wholevoter") + c);
+      create_account_with_resources( voters.back(), config::system_account_name, core_sym::from_string("1.0000"), false, large_asset, large_asset );
+   }
+   for ( const auto& v : voters ) {
+      transfer(config::system_account_name, v, core_sym::from_string("5000.0000"), config::system_account_name);
+      BOOST_REQUIRE_EQUAL(success(), stake(v, core_sym::from_string("333.3333"), core_sym::from_string("111.1111")));
+   }
+
+   // ground truth: the sum of the last weights of the voters of each producer, plus the self stake boosts
+   auto check_totals = [&]() {
+      std::map<account_name, double> expected;
+      for ( const auto& v : voters ) {
+         const auto info = get_voter_info(v);
+         const double weight = info["last_vote_weight"].as<double>();
+         BOOST_REQUIRE_EQUAL(std::floor(weight), weight);
+         const uint64_t boost = info.get_object().contains("self_stake_boost") ? info["self_stake_boost"].as<uint64_t>() : 0;
+         for ( const auto& p : info["producers"].as<std::vector<account_name>>() ) {
+            expected[p] += weight;
+            if ( p == v )
+               expected[p] += std::floor((boost/100.0)*weight);
+         }
+      }
+      double total = 0;
+      for ( const auto& p : producer_names ) {
+         const double votes = get_producer_info(p)["total_votes"].as<double>();
+         BOOST_REQUIRE_EQUAL(expected[p], votes);
+         total += votes;
+      }
+      BOOST_REQUIRE_EQUAL(total, get_global_state()["total_producer_vote_weight"].as<double>());
+   };
+
+   std::mt19937 rng(20250917);
+   auto pick = [&]( uint32_t n ) { return std::uniform_int_distribution<uint32_t>(0, n - 1)(rng); };
+   auto random_asset = [&]() { return core_sym::from_string(std::to_string(1 + pick(90)) + "." + std::to_string(1000 + pick(9000))); };
+
+   for ( int step = 0; step < 60; ++step ) {
+      const auto& v = voters[pick(voters.size())];
+      switch ( pick(4) ) {
+         case 0:
+         case 1: {
+            std::vector<account_name> producers;
+            for ( const auto& p : producer_names )
+               if ( pick(2) ) producers.push_back(p);
+            BOOST_REQUIRE_EQUAL(success(), vote(v, producers));
+            break;
+         }
+         case 2:
+            BOOST_REQUIRE_EQUAL(success(), stake(v, random_asset(), random_asset()));
+            break;
+         case 3:
+            BOOST_REQUIRE_EQUAL(success(), unstake(v, core_sym::from_string("1.0001"), core_sym::from_string("0.3333")));
+            break;
+      }
+      produce_blocks(1);
+      check_totals();
+   }
+
+   // once every vote is withdrawn the totals are back to exactly zero
+   for ( const auto& v : voters )
+      BOOST_REQUIRE_EQUAL(success(), vote(v, {}));
+   produce_blocks(1);
+   check_totals();
+   for ( const auto& p : producer_names )
+      BOOST_REQUIRE_EQUAL(0.0, get_producer_info(p)["total_votes"].as<double>());
+   BOOST_REQUIRE_EQUAL(0.0, get_global_state()["total_producer_vote_weight"].as<double>());
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(merged_producer_vote_deltas, eosio_system_tester) try {
+   const asset large_asset = core_sym::from_string("80.0000");
+   const std::vector<account_name> producer_names = { "defproducera"_n, "defproducerb"_n, "defproducerc"_n, "defproducerd"_n };
+   setup_producer_accounts(producer_names);
+   for (const auto& p : producer_names)
+      BOOST_REQUIRE_EQUAL(success(), regproducer(p));
+   create_account_with_resources( "deltavoter11"_n, config::system_account_name, core_sym::from_string("1.0000"), false, large_asset, large_asset );
+   transfer(config::system_account_name, "deltavoter11"_n, core_sym::from_string("1000.0000"), config::system_account_name);
+   BOOST_REQUIRE_EQUAL(success(), stake("deltavoter11"_n, core_sym::from_string("300.0000"), core_sym::from_string("200.0000")));
+
+   auto total_votes = [&]( const account_name& p ) { return get_producer_info(p)["total_votes"].as<double>(); };
+
+   BOOST_REQUIRE_EQUAL(success(), vote("deltavoter11"_n, { producer_names[0], producer_names[1], producer_names[2] }));
+   const double weight = get_voter_info("deltavoter11"_n)["last_vote_weight"].as<double>();
+   BOOST_REQUIRE_GT(weight, 0);
+
+   // overlapping lists: the dropped producer loses the weight, the kept ones keep it and the added one gains it
+   BOOST_REQUIRE_EQUAL(success(), vote("deltavoter11"_n, { producer_names[1], producer_names[2], producer_names[3] }));
+   BOOST_REQUIRE_EQUAL(0.0, total_votes(producer_names[0]));
+   for ( size_t i = 1; i < producer_names.size(); ++i )
+      BOOST_REQUIRE_EQUAL(weight, total_votes(producer_names[i]));
+   BOOST_REQUIRE_EQUAL(3 * weight, get_global_state()["total_producer_vote_weight"].as<double>());
+
+   // the producers of the new list are still checked in name order
+   BOOST_REQUIRE_EQUAL(wasm_assert_msg("producer alice1111111 is not registered"),
+                       vote("deltavoter11"_n, { "alice1111111"_n, producer_names[1] }));
+   BOOST_REQUIRE_EQUAL(success(), push_action(producer_names[3], "unregprod"_n, mvo()("producer", producer_names[3])));
+   BOOST_REQUIRE_EQUAL(wasm_assert_msg("producer defproducerd is not currently registered"),
+                       vote("deltavoter11"_n, { producer_names[0], producer_names[3] }));
+
+   // an inactive producer can still lose the votes of the previous list
+   BOOST_REQUIRE_EQUAL(success(), vote("deltavoter11"_n, { producer_names[0] }));
+   BOOST_REQUIRE_EQUAL(0.0, total_votes(producer_names[3]));
+   BOOST_REQUIRE_EQUAL(total_votes(producer_names[0]), get_global_state()["total_producer_vote_weight"].as<double>());
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(inverse_vote_weight_table, eosio_system_tester) try {
+   // the weights the formula gives with the sine of the CDT libm, evaluated in WebAssembly as the contract did
+   const account_name tester = "voteweights"_n;
+   create_account_with_resources( tester, config::system_account_name, core_sym::from_string("10.0000"), false );
+   set_code( tester, system_contracts::testing::test_contracts::vote_weights_tester_wasm() );
+   set_abi( tester, system_contracts::testing::test_contracts::vote_weights_tester_abi().data() );
+   const auto trace = base_tester::push_action( tester, "weights"_n, tester, mvo() );
+   const auto weights = fc::raw::unpack<std::vector<double>>( trace->action_traces[0].return_value );
+
+   // every entry is the bit exact result of the formula it replaces
+   BOOST_REQUIRE_EQUAL( eosiosystem::inverse_vote_weights.size(), weights.size() );
+   for ( uint32_t n = 0; n < eosiosystem::inverse_vote_weights.size(); ++n ) {
+      uint64_t expected_bits, table_bits;
+      std::memcpy(&expected_bits, &weights[n], sizeof(double));
+      std::memcpy(&table_bits, &eosiosystem::inverse_vote_weights[n], sizeof(double));
+      BOOST_TEST_CONTEXT("voted producers " << n) {
+         BOOST_REQUIRE_EQUAL(expected_bits, table_bits);
+      }
+   }
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(unchanged_schedule_is_not_proposed_again, eosio_system_tester) try {
+   active_and_vote_producers();
+   produce_blocks( 21 * 12 );
+
+   // the digest of the proposed authorities is kept with the schedule metrics
+   auto metrics = get_gmetrics_state();
+   BOOST_REQUIRE( !metrics["proposed_schedule_digest"].is_null() );
+   const auto digest = metrics["proposed_schedule_digest"].as_string();
+   const auto last_proposed = get_global_state()["last_proposed_schedule_update"].as_string();
+   const auto schedule_version = control->active_producers().version;
+
+   // while the votes do not change, the following elections find the same schedule and leave it alone
+   produce_blocks( 3 * 120 );
+   metrics = get_gmetrics_state();
+   BOOST_REQUIRE_EQUAL( digest, metrics["proposed_schedule_digest"].as_string() );
+   BOOST_REQUIRE_EQUAL( last_proposed, get_global_state()["last_proposed_schedule_update"].as_string() );
+   BOOST_REQUIRE_EQUAL( schedule_version, control->active_producers().version );
+   BOOST_REQUIRE_EQUAL( metrics["producers_metric"].get_array().size(), metrics["proposed_schedule"]["size"].as<uint32_t>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(batched_vote_updates, eosio_system_tester) try {
+   const asset large_asset = core_sym::from_string("80.0000");
+   const std::vector<account_name> producer_names = { "defproducera"_n, "defproducerb"_n, "defproducerc"_n };
+   setup_producer_accounts(producer_names);
+   for (const auto& p : producer_names)
+      BOOST_REQUIRE_EQUAL(success(), regproducer(p));
+   BOOST_REQUIRE_EQUAL(success(), push_action(config::system_account_name, "setselfstake"_n, mvo()("self_stake_boost_multiplier", 10)));
+
+   std::vector<account_name> voters = producer_names;
+   for ( char c = 'a'; c <= 'd'; ++c ) {
+      voters.emplace_back(std::string("batchvoter") + c);
+      create_account_with_resources( voters.back(), config::system_account_name, core_sym::from_string("1.0000"), false, large_asset, large_asset );
+   }
+   for ( const auto& v : voters ) {
+      transfer(config::system_account_name, v, core_sym::from_string("1000.0000"), config::system_account_name);
+      BOOST_REQUIRE_EQUAL(success(), stake(v, core_sym::from_string("200.0000"), core_sym::from_string("100.0000")));
+      BOOST_REQUIRE_EQUAL(success(), vote(v, producer_names));
+   }
+   produce_blocks(1);
+
+   auto voteupdbatch = [&]( const std::vector<account_name>& batch ) {
+      return push_action( "alice1111111"_n, "voteupdbatch"_n, mvo()("voters", batch) );
+   };
+   auto voteupdall = [&]( uint16_t max ) {
+      return push_action( "alice1111111"_n, "voteupdall"_n, mvo()("max", max) );
+   };
+   auto get_vote_update_state = [&]() {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, "voteupdall"_n, "voteupdall"_n );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "vote_update_state", data, abi_serializer::create_yield_function(abi_serializer_max_time) );
+   };
+   auto producer_votes = [&]() {
+      std::vector<double> votes;
+      for (const auto& p : producer_names)
+         votes.push_back(get_producer_info(p)["total_votes"].as<double>());
+      return votes;
+   };
+
+   // nothing changed, anyone can refresh any voter and the totals stay the same
+   const auto votes_before = producer_votes();
+   BOOST_REQUIRE_EQUAL(success(), voteupdbatch(voters));
+   BOOST_REQUIRE(votes_before == producer_votes());
+   BOOST_REQUIRE_EQUAL(wasm_assert_msg("no voter found"), voteupdbatch({ voters[0], "nobody111111"_n }));
+   BOOST_REQUIRE_EQUAL(wasm_assert_msg("no voters to update"), voteupdbatch({}));
+
+   // a higher self stake boost reaches the producers voting for themselves once they are refreshed
+   BOOST_REQUIRE_EQUAL(success(), push_action(config::system_account_name, "setselfstake"_n, mvo()("self_stake_boost_multiplier", 20)));
+   BOOST_REQUIRE_EQUAL(success(), voteupdbatch({ producer_names[0], voters.back() }));
+   auto votes = producer_votes();
+   BOOST_REQUIRE_GT(votes[0], votes_before[0]);
+   BOOST_REQUIRE_EQUAL(votes_before[1], votes[1]);
+   BOOST_REQUIRE_EQUAL(20u, get_voter_info(producer_names[0])["self_stake_boost"].as<uint64_t>());
+
+   // the crank resumes from its cursor and refreshes the remaining producers
+   BOOST_REQUIRE_EQUAL(wasm_assert_msg("max must be positive"), voteupdall(0));
+   uint32_t calls = 0;
+   do {
+      BOOST_REQUIRE_EQUAL(success(), voteupdall(2));
+      produce_blocks(1);
+      ++calls;
+   } while ( !get_vote_update_state().is_null() && calls < 100 );
+   BOOST_REQUIRE(get_vote_update_state().is_null());
+   BOOST_REQUIRE_GT(calls, 1u);
+   votes = producer_votes();
+   for ( size_t i = 1; i < producer_names.size(); ++i )
+      BOOST_REQUIRE_GT(votes[i], votes_before[i]);
+   double total = 0;
+   for ( double v : votes )
+      total += v;
+   BOOST_REQUIRE_EQUAL(total, get_global_state()["total_producer_vote_weight"].as<double>());
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(delegated_stake_total, eosio_system_tester) try {
+   activate_network();
+   const asset large_asset = core_sym::from_string("80.0000");
+   const account_name delegator = "delegator111"_n;
+   const std::vector<account_name> receivers = { "receivera111"_n, "receiverb111"_n, "receiverc111"_n };
+   create_account_with_resources( delegator, config::system_account_name, core_sym::from_string("1.0000"), false, large_asset, large_asset );
+   for ( const auto& r : receivers )
+      create_account_with_resources( r, config::system_account_name, core_sym::from_string("1.0000"), false, large_asset, large_asset );
+   transfer(config::system_account_name, delegator, core_sym::from_string("1000.0000"), config::system_account_name);
+
+   auto auditdeleg = [&]( const account_name& account ) {
+      return push_action( "alice1111111"_n, "auditdeleg"_n, mvo()("account", account) );
+   };
+   auto delegated = [&]() {
+      return get_voter_info(delegator)["reserved3"].as<asset>();
+   };
+
+   // the total follows every delegation to and from the receivers
+   BOOST_REQUIRE_EQUAL(success(), stake(delegator, core_sym::from_string("10.0000"), core_sym::from_string("5.0000")));
+   BOOST_REQUIRE_EQUAL(core_sym::from_string("15.0000"), delegated());
+   for ( const auto& r : receivers )
+      BOOST_REQUIRE_EQUAL(success(), stake(delegator, r, core_sym::from_string("20.0000"), core_sym::from_string("10.0000")));
+   BOOST_REQUIRE_EQUAL(core_sym::from_string("105.0000"), delegated());
+   BOOST_REQUIRE_EQUAL(success(), unstake(delegator, receivers[0], core_sym::from_string("20.0000"), core_sym::from_string("10.0000")));
+   BOOST_REQUIRE_EQUAL(success(), unstake(delegator, receivers[1], core_sym::from_string("5.0000"), core_sym::from_string("0.0000")));
+   BOOST_REQUIRE_EQUAL(core_sym::from_string("70.0000"), delegated());
+   BOOST_REQUIRE_EQUAL(success(), unstaketorex(delegator, receivers[2], core_sym::from_string("10.0000"), core_sym::from_string("0.0000")));
+   BOOST_REQUIRE_EQUAL(core_sym::from_string("60.0000"), delegated());
+   BOOST_REQUIRE_EQUAL(success(), auditdeleg(delegator));
+
+   // voteupdate refreshes staked from the kept total and the REX vote stake
+   BOOST_REQUIRE_EQUAL(success(), push_action( delegator, "voteupdate"_n, mvo()("voter_name", delegator) ));
+   const auto voter = get_voter_info(delegator);
+   BOOST_REQUIRE_EQUAL(core_sym::from_string("60.0000").get_amount() + get_rex_vote_stake(delegator).get_amount(),
+                       voter["staked"].as<int64_t>());
+   BOOST_REQUIRE_EQUAL(core_sym::from_string("60.0000"), voter["reserved3"].as<asset>());
+
+   BOOST_REQUIRE_EQUAL(wasm_assert_msg("no voter found"), auditdeleg("nobody111111"_n));
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(rex_maturities_mature_as_prefix, eosio_system_tester) try {
+   const account_name alice = "aliceaccount"_n;
+   setup_rex_accounts( { alice }, core_sym::from_string("1000.0000") );
+
+   // one maturity bucket per day of purchase
+   std::vector<int64_t> bought;
+   for ( int day = 0; day < 3; ++day ) {
+      const int64_t before = get_rex_balance(alice).get_amount();
+      BOOST_REQUIRE_EQUAL(success(), buyrex(alice, core_sym::from_string("10.0000")));
+      bought.push_back(get_rex_balance(alice).get_amount() - before);
+      produce_block(fc::days(1));
+      produce_blocks(2);
+   }
+   BOOST_REQUIRE_EQUAL(3, get_rex_balance_obj(alice)["rex_maturities"].get_array().size());
+
+   // nothing matured yet, updaterex leaves the buckets as they are
+   BOOST_REQUIRE_EQUAL(success(), updaterex(alice));
+   BOOST_REQUIRE_EQUAL(0, get_rex_balance_obj(alice)["matured_rex"].as<int64_t>());
+   BOOST_REQUIRE_EQUAL(3, get_rex_balance_obj(alice)["rex_maturities"].get_array().size());
+
+   // six days after the first purchase, the first two buckets matured, the last one is pending
+   produce_block(fc::days(3));
+   produce_blocks(2);
+   BOOST_REQUIRE_EQUAL(success(), updaterex(alice));
+   const auto rb = get_rex_balance_obj(alice);
+   BOOST_REQUIRE_EQUAL(bought[0] + bought[1], rb["matured_rex"].as<int64_t>());
+   BOOST_REQUIRE_EQUAL(1, rb["rex_maturities"].get_array().size());
+   BOOST_REQUIRE_EQUAL(bought[2], rb["rex_maturities"].get_array()[0]["second"].as<int64_t>());
+
+   // consolidating merges the pending and matured REX into a single bucket
+   BOOST_REQUIRE_EQUAL(success(), consolidate(alice));
+   const auto consolidated = get_rex_balance_obj(alice);
+   BOOST_REQUIRE_EQUAL(0, consolidated["matured_rex"].as<int64_t>());
+   BOOST_REQUIRE_EQUAL(1, consolidated["rex_maturities"].get_array().size());
+   BOOST_REQUIRE_EQUAL(bought[0] + bought[1] + bought[2], consolidated["rex_maturities"].get_array()[0]["second"].as<int64_t>());
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(evm_slot_keys_layout, eosio_system_tester) try {
+   setup_evm_voting();
+   setup_producer_accounts( { "defproducera"_n, "defproducerb"_n } );
+   BOOST_REQUIRE_EQUAL( success(), regproducer( "defproducera"_n ) );
+   BOOST_REQUIRE_EQUAL( success(), regproducer( "defproducerb"_n ) );
+   BOOST_REQUIRE_EQUAL( success(), push_action( "defproducerb"_n, "unregprod"_n, mvo()("producer", "defproducerb") ) );
+
+   // keccak256 of 64 bytes holding the producer name in bytes 24 to 31, big endian, and the storage slot in byte 63:
+   // the keys of the producer in the `mapping(uint64 => ...)` at slots 3 (votes) and 4 (status) of the voting contract.
+   // defproducera is 0x4a975bd13a42ae60, defproducerb 0x4a975bd13a42ae70.
+   const std::string vote_key_a   = "dce8ec054f775947ae05b36ed7a6668b0a2d194c199d494899e26122f5fefaf5";
+   const std::string status_key_a = "db6a0f494df6cb9272105aff780f71f3906b1f203d5fa91f7521df753fade925";
+   const std::string vote_key_b   = "0d3a0df20fddf2ea76577384ef1f45c0619b7daecdbd9c9078950856102b2a01";
+   // 5 * 10^14 wei, one unit of vote weight is 10^14 wei
+   const std::string five_units   = "0000000000000000000000000000000000000000000000000001c6bf52634000";
+   set_evm_voting_state( vote_key_a, five_units );
+   set_evm_voting_state( vote_key_b, five_units );
+
+   // the vote is found under the expected key, and the keys of the active producer are kept
+   BOOST_REQUIRE_EQUAL( success(), push_action( "alice1111111"_n, "getevmvote"_n, mvo()("bps", std::vector<account_name>{ "defproducera"_n }) ) );
+   const auto keys = get_evm_slot_keys( "defproducera"_n );
+   BOOST_REQUIRE( !keys.is_null() );
+   BOOST_REQUIRE_EQUAL( vote_key_a, keys["vote_key"].as_string() );
+   BOOST_REQUIRE_EQUAL( status_key_a, keys["status_key"].as_string() );
+
+   // anyone can sync an unregistered producer, its keys are computed but not stored at the system account's expense
+   BOOST_REQUIRE_EQUAL( success(), push_action( "alice1111111"_n, "getevmvote"_n, mvo()("bps", std::vector<account_name>{ "defproducerb"_n }) ) );
+   BOOST_REQUIRE( get_evm_slot_keys( "defproducerb"_n ).is_null() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(evm_vote_sync_resumes_from_cursor, eosio_system_tester) try {
+   setup_evm_voting();
+   const std::vector<account_name> producer_names = { "defproducera"_n, "defproducerb"_n, "defproducerc"_n, "defproducerd"_n };
+   setup_producer_accounts( producer_names );
+   for ( const auto& p : producer_names )
+      BOOST_REQUIRE_EQUAL( success(), regproducer( p ) );
+   BOOST_REQUIRE_EQUAL( success(), push_action( "defproducerc"_n, "unregprod"_n, mvo()("producer", "defproducerc") ) );
+
+   // vote keys of the producers in the EVM voting contract, see evm_slot_keys_layout
+   const std::map<account_name, std::string> vote_keys = {
+      { "defproducera"_n, "dce8ec054f775947ae05b36ed7a6668b0a2d194c199d494899e26122f5fefaf5" },
+      { "defproducerb"_n, "0d3a0df20fddf2ea76577384ef1f45c0619b7daecdbd9c9078950856102b2a01" },
+      { "defproducerc"_n, "c11c324d2e3325f08e3ba168a7169e655dcf0da9a4dac2f93a0a60b6b3f6740b" },
+      { "defproducerd"_n, "90ace37156797d6f1031efcf09c340e30b2a63264133579d1681705558a6820b" }
+   };
+   // EVM votes in wei, 10^14 wei per unit of vote weight
+   const std::string three_units = "000000000000000000000000000000000000000000000000000110d9316ec000";
+   const std::string four_units  = "00000000000000000000000000000000000000000000000000016bcc41e90000";
+   const std::string five_units  = "0000000000000000000000000000000000000000000000000001c6bf52634000";
+   const std::string seven_units = "00000000000000000000000000000000000000000000000000027ca57357c000";
+   const std::string nine_units  = "0000000000000000000000000000000000000000000000000003328b944c4000";
+   auto set_evm_vote = [&]( const account_name& bp, const std::string& value ) {
+      set_evm_voting_state( vote_keys.at( bp ), value );
+   };
+   auto evmvotesync = [&]( uint16_t max ) {
+      return push_action( "alice1111111"_n, "evmvotesync"_n, mvo()("max", max) );
+   };
+   auto counted_evm_vote = [&]( const account_name& bp ) {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, "evmvotes"_n, bp );
+      return data.empty() ? std::string() : abi_ser.binary_to_variant( "evm_vote_info", data, abi_serializer_max_time )["total_vote"].as_string();
+   };
+
+   // defproducerd has no EVM vote yet, the unregistered defproducerc has one that was never counted
+   set_evm_vote( "defproducera"_n, five_units );
+   set_evm_vote( "defproducerb"_n, seven_units );
+   set_evm_vote( "defproducerc"_n, nine_units );
+
+   // the first call syncs two producers and keeps its cursor
+   BOOST_REQUIRE_EQUAL( success(), evmvotesync( 2 ) );
+   auto state = get_evm_vote_sync_state();
+   BOOST_REQUIRE( !state.is_null() );
+   BOOST_REQUIRE_EQUAL( "defproducerc"_n, state["next_producer"].as<account_name>() );
+   BOOST_REQUIRE_EQUAL( 2u, state["producers_synced"].as<uint64_t>() );
+   BOOST_REQUIRE_EQUAL( five_units, counted_evm_vote( "defproducera"_n ) );
+   BOOST_REQUIRE_EQUAL( seven_units, counted_evm_vote( "defproducerb"_n ) );
+   const double votes_a = get_producer_info( "defproducera"_n )["total_votes"].as<double>();
+   BOOST_REQUIRE_GT( votes_a, 0 );
+
+   // votes change on both sides of the cursor, the pass resumes after defproducerb and completes
+   set_evm_vote( "defproducera"_n, three_units );
+   set_evm_vote( "defproducerd"_n, four_units );
+   produce_blocks( 1 );
+   BOOST_REQUIRE_EQUAL( success(), evmvotesync( 2 ) );
+   BOOST_REQUIRE( get_evm_vote_sync_state().is_null() );
+   BOOST_REQUIRE_EQUAL( five_units, counted_evm_vote( "defproducera"_n ) );
+   BOOST_REQUIRE_EQUAL( four_units, counted_evm_vote( "defproducerd"_n ) );
+   // the inactive producer is skipped, its keys are not even computed and stored
+   BOOST_REQUIRE( counted_evm_vote( "defproducerc"_n ).empty() );
+   BOOST_REQUIRE( get_evm_slot_keys( "defproducerc"_n ).is_null() );
+   BOOST_REQUIRE_EQUAL( 0, get_producer_info( "defproducerc"_n )["total_votes"].as<double>() );
+
+   // the next pass starts over and picks up the change behind the cursor
+   produce_blocks( 1 );
+   BOOST_REQUIRE_EQUAL( success(), evmvotesync( 10 ) );
+   BOOST_REQUIRE( get_evm_vote_sync_state().is_null() );
+   BOOST_REQUIRE_EQUAL( three_units, counted_evm_vote( "defproducera"_n ) );
+   BOOST_REQUIRE_LT( get_producer_info( "defproducera"_n )["total_votes"].as<double>(), votes_a );
+
+   // a producer unregistered after its EVM vote was counted keeps being synced
+   BOOST_REQUIRE_EQUAL( success(), push_action( "defproducerb"_n, "unregprod"_n, mvo()("producer", "defproducerb") ) );
+   set_evm_vote( "defproducerb"_n, nine_units );
+   produce_blocks( 1 );
+   BOOST_REQUIRE_EQUAL( success(), evmvotesync( 10 ) );
+   BOOST_REQUIRE_EQUAL( nine_units, counted_evm_vote( "defproducerb"_n ) );
+} FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()
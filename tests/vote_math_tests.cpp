@@ -0,0 +1,78 @@
+#include <boost/test/unit_test.hpp>
+#include <fc/exception/exception.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+// The vote kernels are written for contracts, `eosio::check` is the only CDT function they need
+namespace eosio {
+   inline void check( bool pred, const std::string& msg ) {
+      if( !pred ) throw std::runtime_error( msg );
+   }
+}
+
+#include <eosio.system/vote_math.hpp>
+
+namespace {
+   using uint128 = unsigned __int128;
+   namespace vote_math = eosiosystem::vote_math;
+
+   uint64_t bits( double d ) {
+      uint64_t b;
+      std::memcpy( &b, &d, sizeof( b ) );
+      return b;
+   }
+
+   // The longest decay the 128-bit path computes for a yearly rate
+   uint64_t max_fast_path_seconds( uint64_t decay_increase_yearly_pct ) {
+      const uint128 yearly_rate_scaled = uint128{ decay_increase_yearly_pct } * vote_math::decay_precision_u64 / vote_math::percent_denominator;
+      const uint128 max_seconds = yearly_rate_scaled == 0 ? ~uint128{ 0 } : ~uint128{ 0 } / yearly_rate_scaled;
+      return max_seconds > std::numeric_limits<uint64_t>::max() ? std::numeric_limits<uint64_t>::max() : uint64_t( max_seconds );
+   }
+}
+
+BOOST_AUTO_TEST_SUITE(vote_math_tests)
+
+// Integer and IEEE-754 arithmetic are exact or correctly rounded in both WebAssembly and on the host, so
+// the results here are the ones the contract computes
+BOOST_AUTO_TEST_CASE(decay_fast_path_matches_256_bit_path) try {
+   std::mt19937_64 rng( 11 );
+
+   // the rates `setvotedecay` accepts, over up to a century of decay, always take the 128-bit path
+   for( int i = 0; i < 100000; ++i ) {
+      const uint64_t pct = rng() % 101;
+      const uint64_t seconds = 1 + rng() % ( 100 * vote_math::seconds_per_year );
+      const auto fast = vote_math::decay_multiplier_128( seconds, pct );
+      BOOST_REQUIRE( fast.has_value() );
+      BOOST_REQUIRE_EQUAL( bits( vote_math::decay_multiplier_256( seconds, pct ) ), bits( *fast ) );
+   }
+
+   // on both sides of the switch to the 256-bit path
+   for( int i = 0; i < 100000; ++i ) {
+      const uint64_t pct = rng() >> ( rng() % 40 );
+      const uint64_t limit = max_fast_path_seconds( pct );
+      BOOST_REQUIRE_LT( limit, std::numeric_limits<uint64_t>::max() );
+      for( const uint64_t seconds : { limit - 1, limit } ) {
+         const auto fast = vote_math::decay_multiplier_128( seconds, pct );
+         BOOST_REQUIRE( fast.has_value() );
+         BOOST_REQUIRE_EQUAL( bits( vote_math::decay_multiplier_256( seconds, pct ) ), bits( *fast ) );
+      }
+      BOOST_REQUIRE( !vote_math::decay_multiplier_128( limit + 1, pct ).has_value() );
+   }
+
+   // the dispatch, before and after the start of the decay
+   BOOST_REQUIRE_EQUAL( 1.0, vote_math::decay_multiplier( 1000, 0, 50 ) );
+   BOOST_REQUIRE_EQUAL( 1.0, vote_math::decay_multiplier( 1000, 1000, 50 ) );
+   BOOST_REQUIRE_EQUAL( 1.5, vote_math::decay_multiplier( 1000 + vote_math::seconds_per_year, 1000, 50 ) );
+   const uint64_t pct = std::numeric_limits<uint64_t>::max();
+   const uint32_t seconds = uint32_t( max_fast_path_seconds( pct ) + 1 );
+   BOOST_REQUIRE_EQUAL( bits( vote_math::decay_multiplier_256( seconds, pct ) ), bits( vote_math::decay_multiplier( 1 + seconds, 1, pct ) ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()